@@ -30,6 +30,7 @@
 
 #include <wizard_engine/assets.hpp>
 #include <wizard_engine/export.hpp>
+#include <wizard_engine/texture_atlas.hpp>
 
 namespace wze {
 /**
@@ -39,9 +40,29 @@ namespace wze {
 class animatable {
   public:
     /**
-     * @brief Default virtual destructor.
+     * @brief Default constructor.
      */
-    virtual ~animatable() = default;
+    animatable() = default;
+
+    /**
+     * @brief Copy constructor, attaches the object to the animator of the
+     * other object with the same phase.
+     * @param other Other animatable object.
+     */
+    animatable(animatable const& other);
+
+    /**
+     * @brief Virtual destructor, detaches the object from its animator.
+     */
+    virtual ~animatable();
+
+    /**
+     * @brief Copy assignment operator, attaches the object to the animator of
+     * the other object with the same phase.
+     * @param other Other animatable object.
+     * @return Self reference.
+     */
+    animatable& operator=(animatable const& other);
 
     /**
      * @brief Gets whether the object should be animated.
@@ -54,6 +75,12 @@ class animatable {
      * @param texture wze::texture of the object.
      */
     virtual void set_texture(std::shared_ptr<texture> const& texture) = 0;
+
+    /**
+     * @brief Sets the drawn wze::texture_region of the object.
+     * @param region wze::texture_region of the object.
+     */
+    virtual void set_region(texture_region const& region) = 0;
 };
 } /* namespace wze */
 
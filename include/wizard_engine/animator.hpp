@@ -25,103 +25,239 @@
 #include <wizard_engine/animatable.hpp>
 #include <wizard_engine/assets.hpp>
 #include <wizard_engine/export.hpp>
+#include <wizard_engine/texture_atlas.hpp>
 
 namespace wze {
+class animator;
+
+/**
+ * @file animator.hpp
+ * @author Zana Domán
+ * @brief Animated targets stored as structure of arrays.
+ */
+struct animation_tracks {
+    std::vector<animatable*> target;
+    std::vector<animator*> clock;
+    std::vector<uint32_t> phase;
+    std::vector<size_t> frame;
+};
+
 /**
  * @file animator.hpp
  * @author Zana Domán
- * @brief Animates animatable objects.
+ * @brief Clock of an animation shared by its targets.
+ * @note The engine advances every animator and animates every target in one
+ * pass per frame, a target is only updated when its frame changes.
  */
 class animator final {
   public:
+#ifdef __WIZARD_ENGINE_INTERNAL__
+    /**
+     * @file animator.hpp
+     * @author Zana Domán
+     * @brief Advances the animators and animates their targets.
+     */
+    static void update();
+#endif /* __WIZARD_ENGINE_INTERNAL__ */
+
+#ifdef __WIZARD_ENGINE_INTERNAL__
+    /**
+     * @file animator.hpp
+     * @author Zana Domán
+     * @brief Detaches a target from its animator.
+     * @param target Detached target.
+     */
+    static void release(animatable const* target);
+#endif /* __WIZARD_ENGINE_INTERNAL__ */
+
+#ifdef __WIZARD_ENGINE_INTERNAL__
+    /**
+     * @file animator.hpp
+     * @author Zana Domán
+     * @brief Attaches a target to the animator of a source with the same
+     * phase, detaches it if the source is not animated.
+     * @param source Copied target.
+     * @param target Attached target.
+     */
+    static void copy(animatable const& source, animatable& target);
+#endif /* __WIZARD_ENGINE_INTERNAL__ */
+
     /**
      * @file animator.hpp
      * @author Zana Domán
      * @brief Constructs an animator instance.
      * @param frames Frame pool of the animation.
-     * @param targets Targets of the animation.
      */
     explicit animator(
-        std::vector<std::pair<std::shared_ptr<texture>, uint16_t>> const&
-            frames = {},
-        std::vector<std::weak_ptr<animatable>> const& targets = {});
+        std::vector<std::pair<texture_region, uint16_t>> const& frames = {});
+
+    /**
+     * @file animator.hpp
+     * @author Zana Domán
+     * @brief Copy constructor.
+     * @param other Other animator instance.
+     * @note The targets of the other animator are not copied.
+     */
+    animator(animator const& other);
+
+    /**
+     * @file animator.hpp
+     * @author Zana Domán
+     * @brief Destroys the animator instance and detaches its targets.
+     */
+    ~animator();
+
+    /**
+     * @file animator.hpp
+     * @author Zana Domán
+     * @brief Copy assignment operator.
+     * @param other Other animator instance.
+     * @return Self reference.
+     * @note The targets of the other animator are not copied.
+     */
+    animator& operator=(animator const& other);
 
     /**
      * @file animator.hpp
      * @author Zana Domán
      * @brief Returns the frame pool of the animation.
      * @return Frame pool of the animation.
+     * @note The duration of the frames is given in milliseconds, frames with
+     * zero duration are skipped.
      */
-    [[nodiscard]] std::vector<
-        std::pair<std::shared_ptr<texture>, uint16_t>> const&
+    [[nodiscard]] std::vector<std::pair<texture_region, uint16_t>> const&
     frames() const;
 
     /**
      * @file animator.hpp
      * @author Zana Domán
-     * @brief Returns the frame pool of the animation.
-     * @return Frame pool of the animation.
+     * @brief Sets the frame pool of the animation.
+     * @param frames Frame pool of the animation.
+     * @note The targets are updated at the next frame even if their frame
+     * does not change.
      */
-    [[nodiscard]] std::vector<std::pair<std::shared_ptr<texture>, uint16_t>>&
-    frames();
+    void set_frames(
+        std::vector<std::pair<texture_region, uint16_t>> const& frames);
 
     /**
      * @file animator.hpp
      * @author Zana Domán
-     * @brief Returns the targets of the animation.
-     * @return Targets of the animation.
+     * @brief Returns the number of targets of the animation.
+     * @return Number of targets of the animation.
      */
-    [[nodiscard]] std::vector<std::weak_ptr<animatable>> const& targets() const;
+    [[nodiscard]] size_t targets() const;
 
     /**
      * @file animator.hpp
      * @author Zana Domán
-     * @brief Returns the targets of the animation.
-     * @return Targets of the animation.
+     * @brief Attaches a target to the animation.
+     * @param target Attached target.
+     * @param phase Offset of the target on the clock in milliseconds.
+     * @note A target is attached to one animation at a time, it is detached
+     * from its previous animation. Targets detach themselves on destruction.
      */
-    [[nodiscard]] std::vector<std::weak_ptr<animatable>>& targets();
+    void attach(animatable& target, uint32_t phase = 0);
 
     /**
      * @file animator.hpp
      * @author Zana Domán
-     * @brief Returns the current frame of the animation.
-     * @return Current frame of the animation.
-     * @note Can be invalid.
+     * @brief Detaches a target from the animation.
+     * @param target Detached target.
      */
-    [[nodiscard]] size_t current_frame() const;
+    void detach(animatable const& target);
+
+    /**
+     * @file animator.hpp
+     * @author Zana Domán
+     * @brief Returns the elapsed time of the current loop.
+     * @return Elapsed time of the current loop in milliseconds.
+     */
+    [[nodiscard]] float time() const;
+
+    /**
+     * @file animator.hpp
+     * @author Zana Domán
+     * @brief Sets the elapsed time of the current loop.
+     * @param time Elapsed time of the current loop in milliseconds.
+     */
+    void set_time(float time);
+
+    /**
+     * @file animator.hpp
+     * @author Zana Domán
+     * @brief Returns whether the clock is running or not.
+     * @return Whether the clock is running or not.
+     */
+    [[nodiscard]] bool playing() const;
 
     /**
      * @file animator.hpp
      * @author Zana Domán
-     * @brief Sets the current frame of the animation.
-     * @param current_frame Current frame of the animation.
-     * @note Can be invalid.
+     * @brief Sets whether the clock is running or not.
+     * @param playing Whether the clock is running or not.
      */
-    void set_current_frame(size_t current_frame);
+    void set_playing(bool playing);
 
     /**
      * @file animator.hpp
      * @author Zana Domán
-     * @brief Animates the targets and erases expired ones, then returns whether
-     * the animation is looped or not.
-     * @return Whether the animation is looped or not.
-     * @note You need to call this function in every frame to progress the
-     * animation.
+     * @brief Returns the number of completed loops.
+     * @return Number of completed loops.
      */
-    bool play();
+    [[nodiscard]] size_t loops() const;
 
     /**
      * @file animator.hpp
      * @author Zana Domán
-     * @brief Resets the animation.
+     * @brief Returns the current frame of the animation without phase offset.
+     * @return Current frame of the animation.
+     * @note Invalid if the frame pool is empty.
+     */
+    [[nodiscard]] size_t current_frame() const;
+
+    /**
+     * @file animator.hpp
+     * @author Zana Domán
+     * @brief Resets the clock of the animation.
      */
     void reset();
 
   private:
-    std::vector<std::pair<std::shared_ptr<texture>, uint16_t>> _frames;
-    std::vector<std::weak_ptr<animatable>> _targets;
-    size_t _current_frame;
-    uint16_t _remaining_time;
+    static animation_tracks _tracks;
+    static std::unordered_map<animatable const*, size_t> _indices;
+    static std::vector<animator*> _instances;
+    std::vector<std::pair<texture_region, uint16_t>> _frames;
+    std::vector<uint32_t> _starts;
+    uint32_t _period;
+    size_t _targets;
+    float _time;
+    bool _playing;
+    size_t _loops;
+    bool _dirty;
+
+    /**
+     * @file animator.hpp
+     * @author Zana Domán
+     * @brief Erases a track by moving the last track into its place.
+     * @param index Index of the erased track.
+     */
+    static void erase(size_t index);
+
+    /**
+     * @file animator.hpp
+     * @author Zana Domán
+     * @brief Advances the clock and measures the frames of the animation.
+     */
+    void advance();
+
+    /**
+     * @file animator.hpp
+     * @author Zana Domán
+     * @brief Returns the frame shown at a point of the clock.
+     * @param time Point of the clock in milliseconds.
+     * @return Frame shown at the point of the clock.
+     */
+    [[nodiscard]] size_t frame(uint32_t time) const;
 };
 } /* namespace wze */
 
@@ -24,6 +24,7 @@
 
 #include <wizard_engine/enums.hpp>
 #include <wizard_engine/export.hpp>
+#include <wizard_engine/pack.hpp>
 
 namespace wze {
 /**
@@ -64,6 +65,16 @@ using font = TTF_Font;
  */
 using cursor = SDL_Cursor;
 
+/**
+ * @file assets.hpp
+ * @author Zana Domán
+ * @brief Statistics of the asset cache.
+ */
+struct cache_stats {
+    size_t hits;
+    size_t misses;
+};
+
 /**
  * @file assets.hpp
  * @author Zana Domán
@@ -71,6 +82,16 @@ using cursor = SDL_Cursor;
  */
 class assets final {
   private:
+    /**
+     * @file assets.hpp
+     * @author Zana Domán
+     * @brief Texture cached for an image.
+     */
+    struct texture_entry {
+        std::weak_ptr<wze::image> image;
+        std::weak_ptr<wze::texture> texture;
+    };
+
     /**
      * @file assets.hpp
      * @author Zana Domán
@@ -84,6 +105,63 @@ class assets final {
 #endif /* __ANDROID__ */
         ;
 
+    static bool _caching;
+    static std::unordered_map<std::string, std::weak_ptr<image>> _images;
+    static std::unordered_map<image*, texture_entry> _textures;
+    static std::unordered_map<uint64_t, std::weak_ptr<texture>> _digests;
+    static std::unordered_map<std::string, std::weak_ptr<sound>> _sounds;
+    static std::unordered_map<std::string, std::weak_ptr<font>> _fonts;
+    static wze::cache_stats _cache_stats;
+
+    /**
+     * @file assets.hpp
+     * @author Zana Domán
+     * @brief Maximum number of workers loading the assets.
+     */
+    static constexpr size_t _max_loaders = 2;
+
+    static SDL_mutex* _mutex;
+    static SDL_sem* _queued;
+    static SDL_cond* _idle;
+    static size_t _loaders;
+    static std::deque<std::function<void()>> _jobs;
+    static std::vector<std::function<bool()>> _uploads;
+    static size_t _pending;
+    static size_t _completed;
+    static float _upload_budget;
+    static std::vector<std::pair<std::string, std::shared_ptr<pack>>> _packs;
+    static std::unordered_map<std::string, std::weak_ptr<texture>>
+        _texture_files;
+
+    /**
+     * @file assets.hpp
+     * @author Zana Domán
+     * @brief Header of a pre-decoded texture file.
+     * @note The header is followed by the rows of pixels without padding.
+     */
+    struct texture_header {
+        std::array<char, 8> magic;
+        uint32_t format;
+        uint32_t width;
+        uint32_t height;
+        uint32_t flags;
+    };
+
+    /**
+     * @file assets.hpp
+     * @author Zana Domán
+     * @brief Magic of a pre-decoded texture file.
+     */
+    static constexpr std::array<char, 8> _texture_magic = {
+        'W', 'Z', 'E', 'T', 'E', 'X', '\0', '\0'};
+
+    /**
+     * @file assets.hpp
+     * @author Zana Domán
+     * @brief Flag of the pre-decoded texture files with premultiplied alpha.
+     */
+    static constexpr uint32_t _premultiplied = 1;
+
     /**
      * @file assets.hpp
      * @author Zana Domán
@@ -91,6 +169,70 @@ class assets final {
      */
     assets() = default;
 
+    /**
+     * @file assets.hpp
+     * @author Zana Domán
+     * @brief Returns the normalized path of an asset.
+     * @param path Path to the asset.
+     * @return Normalized path of the asset.
+     */
+    [[nodiscard]] static std::string normalize(std::string const& path);
+
+    /**
+     * @file assets.hpp
+     * @author Zana Domán
+     * @brief Returns a cached asset, loading it on a miss.
+     * @tparam asset Type of the asset.
+     * @param cache Cache of the asset type.
+     * @param key Key of the asset.
+     * @param load Loads the asset.
+     * @return Cached or loaded asset.
+     */
+    template <typename asset>
+    [[nodiscard]] static std::shared_ptr<asset>
+    cached(std::unordered_map<std::string, std::weak_ptr<asset>>& cache,
+           std::string const& key,
+           std::function<std::shared_ptr<asset>()> const& load);
+
+    /**
+     * @file assets.hpp
+     * @author Zana Domán
+     * @brief Returns the latest mounted pack containing an asset.
+     * @param path Path to the asset.
+     * @return Pack containing the asset, null if it is loaded from a file.
+     */
+    [[nodiscard]] static std::shared_ptr<pack> locate(std::string const& path);
+
+    /**
+     * @file assets.hpp
+     * @author Zana Domán
+     * @brief Entry point of the workers loading the assets.
+     * @param data Unused.
+     * @return Never returns.
+     */
+    static int32_t work(void* data);
+
+    /**
+     * @file assets.hpp
+     * @author Zana Domán
+     * @brief Queues a job for the workers.
+     * @param job Queued job.
+     * @note Without threads the job runs immediately.
+     */
+    static void schedule(std::function<void()> const& job);
+
+    /**
+     * @file assets.hpp
+     * @author Zana Domán
+     * @brief Loads an asset on the workers.
+     * @tparam asset Type of the asset.
+     * @param load Loads the asset.
+     * @return Future of the asset.
+     */
+    template <typename asset>
+    [[nodiscard]] static std::shared_future<std::shared_ptr<asset>>
+    async(std::function<std::shared_ptr<asset>()> const& load);
+
     /**
      * @file assets.hpp
      * @author Zana Domán
@@ -100,7 +242,115 @@ class assets final {
      */
     static void combine_hash(size_t& seed, size_t value);
 
+    /**
+     * @file assets.hpp
+     * @author Zana Domán
+     * @brief State of a streamed digest.
+     * @note Four independent lanes consume 32 byte stripes, so the rounds
+     * are not chained byte by byte.
+     */
+    struct digest_state {
+        std::array<uint64_t, 4> lanes;
+        std::array<uint8_t, 32> buffer;
+        size_t buffered;
+        uint64_t length;
+    };
+
+    /**
+     * @file assets.hpp
+     * @author Zana Domán
+     * @brief Starts a streamed digest.
+     * @return Initial state of the digest.
+     */
+    [[nodiscard]] static digest_state begin_digest();
+
+    /**
+     * @file assets.hpp
+     * @author Zana Domán
+     * @brief Feeds bytes into a streamed digest.
+     * @param state State of the digest.
+     * @param data Fed bytes.
+     * @param size Number of the fed bytes.
+     */
+    static void update_digest(digest_state& state, void const* data,
+                              size_t size);
+
+    /**
+     * @file assets.hpp
+     * @author Zana Domán
+     * @brief Finishes a streamed digest.
+     * @param state State of the digest.
+     * @return Digest of the fed bytes.
+     */
+    [[nodiscard]] static uint64_t end_digest(digest_state const& state);
+
   public:
+    /**
+     * @file assets.hpp
+     * @author Zana Domán
+     * @brief Version of the digests.
+     * @note Digests are stable between runs and platforms as long as the
+     * version stays the same.
+     */
+    static constexpr uint8_t digest_version = 1;
+
+    /**
+     * @file assets.hpp
+     * @author Zana Domán
+     * @brief Returns whether the loaded assets are cached or not.
+     * @return Whether the loaded assets are cached or not.
+     */
+    [[nodiscard]] static bool caching();
+
+    /**
+     * @file assets.hpp
+     * @author Zana Domán
+     * @brief Sets whether the loaded assets are cached or not.
+     * @param caching Whether the loaded assets are cached or not.
+     * @note The cache only holds weak references, an asset is freed once no
+     * one else uses it. Cached assets are shared, changing one changes it
+     * for every user.
+     */
+    static void set_caching(bool caching);
+
+    /**
+     * @file assets.hpp
+     * @author Zana Domán
+     * @brief Mounts a pack of assets.
+     * @param path Path to the pack.
+     * @note The loaders look up their paths in the mounted packs first, the
+     * latest mounted pack wins, then fall back to the files. Assets are read
+     * from the pack without copying it.
+     * @warning If the pack cannot be mapped or is malformed, throws
+     * wze::exception.
+     */
+    static void mount(std::string const& path);
+
+    /**
+     * @file assets.hpp
+     * @author Zana Domán
+     * @brief Unmounts a pack of assets.
+     * @param path Path to the pack.
+     * @note Fonts loaded from the pack keep it mapped until they are freed.
+     */
+    static void unmount(std::string const& path);
+
+    /**
+     * @file assets.hpp
+     * @author Zana Domán
+     * @brief Returns the statistics of the asset cache.
+     * @return Statistics of the asset cache.
+     */
+    [[nodiscard]] static wze::cache_stats const& cache_stats();
+
+    /**
+     * @file assets.hpp
+     * @author Zana Domán
+     * @brief Empties the asset cache and resets its statistics.
+     * @note Assets in use stay alive, they are only forgotten by the cache.
+     */
+    static void clear_cache();
+
     /**
      * @file assets.hpp
      * @author Zana Domán
@@ -108,11 +358,25 @@ class assets final {
      * @param path Path to the image.
      * @return Loaded image.
      * @note Supported image formats: jpg, png.
+     * @note While caching, loading a path again returns the same image as
+     * long as it is in use.
      * @warning If the image cannot be loaded, throws wze::exception.
      */
     [[nodiscard]] static std::shared_ptr<image>
     load_image(std::string const& path);
 
+    /**
+     * @file assets.hpp
+     * @author Zana Domán
+     * @brief Loads an image from a path on a worker thread.
+     * @param path Path to the image.
+     * @return Future of the loaded image.
+     * @note If the image cannot be loaded, the future holds the exception.
+     * @sa load_image
+     */
+    [[nodiscard]] static std::shared_future<std::shared_ptr<image>>
+    load_image_async(std::string const& path);
+
     /**
      * @file assets.hpp
      * @author Zana Domán
@@ -137,17 +401,83 @@ class assets final {
      */
     [[nodiscard]] static size_t hash_image(std::shared_ptr<image> const& image);
 
+    /**
+     * @file assets.hpp
+     * @author Zana Domán
+     * @brief Returns the digest of an image.
+     * @param image Digested image.
+     * @return 64 bit digest of the size, the pixel format and the visible
+     * pixels of the image.
+     * @note The digest is the XXH64 of the streamed data, the padding of the
+     * rows is skipped.
+     * @sa digest_version
+     */
+    [[nodiscard]] static uint64_t
+    digest_image(std::shared_ptr<image> const& image);
+
     /**
      * @file assets.hpp
      * @author Zana Domán
      * @brief Creates a texture from an image.
      * @param image Image of the texture.
      * @return Created texture.
+     * @note While caching, creating a texture from the same image again
+     * returns the same texture as long as it is in use. Images are looked up
+     * by address, only an image without a cached texture is digested to share
+     * the texture of an identical image.
      * @warning If the texture cannot be created, throws wze::exception.
      */
     [[nodiscard]] static std::shared_ptr<texture>
     create_texture(std::shared_ptr<image> const& image);
 
+    /**
+     * @file assets.hpp
+     * @author Zana Domán
+     * @brief Creates a texture from an image once it is loaded.
+     * @param image Future of the image of the texture.
+     * @return Future of the created texture.
+     * @note Textures are created on the main thread by the engine update,
+     * within the upload budget.
+     * @note If the texture cannot be created, the future holds the exception.
+     * @sa create_texture
+     */
+    [[nodiscard]] static std::shared_future<std::shared_ptr<texture>>
+    create_texture_async(
+        std::shared_future<std::shared_ptr<image>> const& image);
+
+    /**
+     * @file assets.hpp
+     * @author Zana Domán
+     * @brief Saves an image as a pre-decoded texture file.
+     * @param image Saved image.
+     * @param path Path to the texture file.
+     * @param premultiplied Whether the alpha is premultiplied or not.
+     * @note The pixels are stored in the preferred pixel format of the
+     * renderer, so this offline step should run with the target renderer.
+     * @warning If the texture file cannot be saved, throws wze::exception.
+     */
+    static void save_texture(std::shared_ptr<image> const& image,
+                             std::string const& path,
+                             bool premultiplied = false);
+
+    /**
+     * @file assets.hpp
+     * @author Zana Domán
+     * @brief Loads a texture from a pre-decoded texture file.
+     * @param path Path to the texture file.
+     * @return Loaded texture.
+     * @note The pixels are uploaded as they are stored, without decoding or
+     * converting them, straight from the memory of a mounted pack.
+     * @note Textures with premultiplied alpha blend with a custom blend mode,
+     * which the software renderer does not support, and their alpha
+     * modifier does not fade their colors.
+     * @note While caching, loading a path again returns the same texture as
+     * long as it is in use.
+     * @warning If the texture cannot be loaded, throws wze::exception.
+     */
+    [[nodiscard]] static std::shared_ptr<texture>
+    load_texture(std::string const& path);
+
     /**
      * @file assets.hpp
      * @author Zana Domán
@@ -155,11 +485,25 @@ class assets final {
      * @param path Path to the sound.
      * @return Loaded sound.
      * @note Supported sound formats: wav, ogg.
+     * @note While caching, loading a path again returns the same sound as
+     * long as it is in use.
      * @warning If the sound cannot be loaded, throws wze::exception.
      */
     [[nodiscard]] static std::shared_ptr<sound>
     load_sound(std::string const& path);
 
+    /**
+     * @file assets.hpp
+     * @author Zana Domán
+     * @brief Loads a sound from a path on a worker thread.
+     * @param path Path to the sound.
+     * @return Future of the loaded sound.
+     * @note If the sound cannot be loaded, the future holds the exception.
+     * @sa load_sound
+     */
+    [[nodiscard]] static std::shared_future<std::shared_ptr<sound>>
+    load_sound_async(std::string const& path);
+
     /**
      * @file assets.hpp
      * @author Zana Domán
@@ -169,6 +513,18 @@ class assets final {
      */
     [[nodiscard]] static size_t hash_sound(std::shared_ptr<sound> const& sound);
 
+    /**
+     * @file assets.hpp
+     * @author Zana Domán
+     * @brief Returns the digest of a sound.
+     * @param sound Digested sound.
+     * @return 64 bit digest of the samples of the sound.
+     * @note The digest is the XXH64 of the samples.
+     * @sa digest_version
+     */
+    [[nodiscard]] static uint64_t
+    digest_sound(std::shared_ptr<sound> const& sound);
+
     /**
      * @file assets.hpp
      * @author Zana Domán
@@ -179,6 +535,8 @@ class assets final {
      * @param alignment Alignment of the font.
      * @return Loaded font.
      * @note Supported font format: ttf.
+     * @note While caching, loading a path with the same size, style and
+     * alignment again returns the same font as long as it is in use.
      * @warning If the font cannot be loaded, throws wze::exception.
      */
     [[nodiscard]] static std::shared_ptr<font>
@@ -187,6 +545,63 @@ class assets final {
               font_style style = FONT_STYLE_NORMAL,
               font_alignment alignment = FONT_ALIGNMENT_LEFT);
 
+    /**
+     * @file assets.hpp
+     * @author Zana Domán
+     * @brief Loads a font from a path on a worker thread.
+     * @param path Path to the font.
+     * @param size Size of the font.
+     * @param style Style of the font.
+     * @param alignment Alignment of the font.
+     * @return Future of the loaded font.
+     * @note If the font cannot be loaded, the future holds the exception.
+     * @sa load_font
+     */
+    [[nodiscard]] static std::shared_future<std::shared_ptr<font>>
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+    load_font_async(std::string const& path, uint8_t size = 48,
+                    font_style style = FONT_STYLE_NORMAL,
+                    font_alignment alignment = FONT_ALIGNMENT_LEFT);
+
+    /**
+     * @file assets.hpp
+     * @author Zana Domán
+     * @brief Returns the number of asynchronous loads and uploads not
+     * finished yet.
+     * @return Number of asynchronous loads and uploads not finished yet.
+     */
+    [[nodiscard]] static size_t pending();
+
+    /**
+     * @file assets.hpp
+     * @author Zana Domán
+     * @brief Returns the number of asynchronous loads and uploads finished.
+     * @return Number of asynchronous loads and uploads finished.
+     * @note The progress of a loading screen is completed / (completed +
+     * pending).
+     */
+    [[nodiscard]] static size_t completed();
+
+    /**
+     * @file assets.hpp
+     * @author Zana Domán
+     * @brief Returns the time spent creating textures per update in
+     * milliseconds.
+     * @return Time spent creating textures per update in milliseconds.
+     */
+    [[nodiscard]] static float upload_budget();
+
+    /**
+     * @file assets.hpp
+     * @author Zana Domán
+     * @brief Sets the time spent creating textures per update in
+     * milliseconds.
+     * @param upload_budget Time spent creating textures per update in
+     * milliseconds.
+     * @note At least one texture is created per update.
+     */
+    static void set_upload_budget(float upload_budget);
+
     /**
      * @file assets.hpp
      * @author Zana Domán
@@ -211,6 +626,28 @@ class assets final {
     [[nodiscard]] static std::unique_ptr<cursor, std::function<void(cursor*)>>
     create_cursor(std::shared_ptr<image> const& image, uint16_t hot_x = 0,
                   uint16_t hot_y = 0);
+
+#ifdef __WIZARD_ENGINE_INTERNAL__
+    /**
+     * @file assets.hpp
+     * @author Zana Domán
+     * @brief Initializes the assets subsystem.
+     * @note The program waits for the queued loads at exit, so no worker
+     * decodes while the engine is torn down.
+     * @warning If the assets subsystem cannot be initialized, throws
+     * wze::exception.
+     */
+    static void initialize();
+#endif /* __WIZARD_ENGINE_INTERNAL__ */
+
+#ifdef __WIZARD_ENGINE_INTERNAL__
+    /**
+     * @file assets.hpp
+     * @author Zana Domán
+     * @brief Updates the assets subsystem.
+     */
+    static void update();
+#endif /* __WIZARD_ENGINE_INTERNAL__ */
 };
 } /* namespace wze */
 
@@ -26,6 +26,20 @@
 #include <wizard_engine/renderable.hpp>
 
 namespace wze {
+/**
+ * @file camera.hpp
+ * @author Zana Domán
+ * @brief State of the camera captured for projecting render proxies.
+ */
+struct camera_view {
+    float x;
+    float y;
+    float z;
+    float angle;
+    float focus;
+    std::array<float, 4> transformation_matrix;
+};
+
 /**
  * @file camera.hpp
  * @author Zana Domán, Gunics Roland
@@ -47,6 +61,55 @@ class camera final {
      */
     camera() = default;
 
+#ifdef __WIZARD_ENGINE_INTERNAL__
+#if defined(__x86_64__)
+    /**
+     * @file camera.hpp
+     * @author Zana Domán
+     * @brief Transforms and projects the drawn render proxies of a range four
+     * at a time using SSE2.
+     * @param view Captured state of the camera.
+     * @param proxies Render proxies.
+     * @param first First render proxy of the range.
+     * @param last Render proxy after the last one of the range.
+     * @return First render proxy left unprocessed.
+     */
+    static size_t project_sse2(camera_view const& view,
+                               render_proxies& proxies, size_t first,
+                               size_t last);
+
+    /**
+     * @file camera.hpp
+     * @author Zana Domán
+     * @brief Transforms and projects the drawn render proxies of a range eight
+     * at a time using AVX2.
+     * @param view Captured state of the camera.
+     * @param proxies Render proxies.
+     * @param first First render proxy of the range.
+     * @param last Render proxy after the last one of the range.
+     * @return First render proxy left unprocessed.
+     */
+    static size_t project_avx2(camera_view const& view,
+                               render_proxies& proxies, size_t first,
+                               size_t last);
+#elif defined(__aarch64__)
+    /**
+     * @file camera.hpp
+     * @author Zana Domán
+     * @brief Transforms and projects the drawn render proxies of a range four
+     * at a time using NEON.
+     * @param view Captured state of the camera.
+     * @param proxies Render proxies.
+     * @param first First render proxy of the range.
+     * @param last Render proxy after the last one of the range.
+     * @return First render proxy left unprocessed.
+     */
+    static size_t project_neon(camera_view const& view,
+                               render_proxies& proxies, size_t first,
+                               size_t last);
+#endif
+#endif /* __WIZARD_ENGINE_INTERNAL__ */
+
   public:
     /**
      * @file camera.hpp
@@ -145,14 +208,43 @@ class camera final {
     static void initialize();
 #endif /* __WIZARD_ENGINE_INTERNAL__ */
 
+#ifdef __WIZARD_ENGINE_INTERNAL__
+    /**
+     * @file camera.hpp
+     * @author Zana Domán
+     * @brief Captures the state of the camera.
+     * @return Captured state of the camera.
+     */
+    [[nodiscard]] static camera_view capture();
+#endif /* __WIZARD_ENGINE_INTERNAL__ */
+
 #ifdef __WIZARD_ENGINE_INTERNAL__
     /**
      * @file camera.hpp
      * @author Zana Domán, Gunics Roland
-     * @brief Transforms and projects a renderable instance.
-     * @param instance Renderable instance.
+     * @brief Transforms and projects a render proxy.
+     * @param view Captured state of the camera.
+     * @param proxies Render proxies.
+     * @param proxy Render proxy.
+     */
+    static void project(camera_view const& view, render_proxies& proxies,
+                        size_t proxy);
+#endif /* __WIZARD_ENGINE_INTERNAL__ */
+
+#ifdef __WIZARD_ENGINE_INTERNAL__
+    /**
+     * @file camera.hpp
+     * @author Zana Domán
+     * @brief Transforms and projects the drawn render proxies of a range with
+     * the widest vector instructions available, the results are identical to
+     * projecting them one by one.
+     * @param view Captured state of the camera.
+     * @param proxies Render proxies.
+     * @param first First render proxy of the range.
+     * @param last Render proxy after the last one of the range.
      */
-    static void project(renderable& instance);
+    static void project(camera_view const& view, render_proxies& proxies,
+                        size_t first, size_t last);
 #endif /* __WIZARD_ENGINE_INTERNAL__ */
 
     /**
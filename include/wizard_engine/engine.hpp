@@ -34,6 +34,12 @@ namespace wze {
 class engine final {
   private:
     static std::vector<SDL_Event> _events;
+    static bool _headless;
+    static size_t _frame_limit;
+    static size_t _frames;
+    static std::function<void()> _tick;
+    static float _tick_time;
+    static float _accumulator;
 
     /**
      * @file engine.hpp
@@ -49,6 +55,13 @@ class engine final {
      */
     static void play_intro();
 
+    /**
+     * @file engine.hpp
+     * @author Zana Domán
+     * @brief Runs the simulation ticks due since the last update.
+     */
+    static void simulate();
+
   public:
 #ifdef __WIZARD_ENGINE_INTERNAL__
     /**
@@ -60,6 +73,71 @@ class engine final {
     [[nodiscard]] static std::vector<SDL_Event> const& events();
 #endif /* __WIZARD_ENGINE_INTERNAL__ */
 
+    /**
+     * @file engine.hpp
+     * @author Zana Domán
+     * @brief Returns whether the engine runs headless or not.
+     * @return Whether the engine runs headless or not.
+     */
+    [[nodiscard]] static bool headless();
+
+    /**
+     * @file engine.hpp
+     * @author Zana Domán
+     * @brief Returns the number of frames after which update returns false.
+     * @return Number of frames after which update returns false, 0 if
+     * unlimited.
+     */
+    [[nodiscard]] static size_t frame_limit();
+
+    /**
+     * @file engine.hpp
+     * @author Zana Domán
+     * @brief Sets the number of frames after which update returns false.
+     * @param frame_limit Number of frames after which update returns false, 0
+     * if unlimited.
+     * @note Counted from the next update.
+     */
+    static void set_frame_limit(size_t frame_limit);
+
+    /**
+     * @file engine.hpp
+     * @author Zana Domán
+     * @brief Returns the simulation callback of the engine.
+     * @return Simulation callback of the engine.
+     */
+    [[nodiscard]] static std::function<void()> const& tick();
+
+    /**
+     * @file engine.hpp
+     * @author Zana Domán
+     * @brief Sets the simulation callback of the engine.
+     * @param tick Simulation callback of the engine, null to simulate in the
+     * game loop.
+     * @note The callback runs from update at the fixed tick time, as many
+     * times as the elapsed time requires. During the callback
+     * wze::timer::delta_time returns the tick time. The frames render the
+     * renderable instances interpolated between the last two ticks.
+     */
+    static void set_tick(std::function<void()> const& tick);
+
+    /**
+     * @file engine.hpp
+     * @author Zana Domán
+     * @brief Returns the time between two simulation ticks in milliseconds.
+     * @return Time between two simulation ticks in milliseconds.
+     */
+    [[nodiscard]] static float tick_time();
+
+    /**
+     * @file engine.hpp
+     * @author Zana Domán
+     * @brief Sets the time between two simulation ticks in milliseconds.
+     * @param tick_time Time between two simulation ticks in milliseconds, 0
+     * disables the simulation callback.
+     */
+    static void set_tick_time(float tick_time);
+
     /**
      * @file engine.hpp
      * @author Zana Domán
@@ -67,12 +145,19 @@ class engine final {
      * @param title Title of the game window.
      * @param width Width of the game window.
      * @param height Height of the game window.
+     * @param headless Whether the engine runs headless or not.
      * @note This method is automatically called when wze_main is used.
+     * @note A headless engine uses the dummy video and audio drivers with the
+     * software renderer, skips the intro and defaults to a fixed delta time,
+     * so its frames are reproducible. The engine also runs headless if the
+     * WZE_HEADLESS environment variable is set to anything but "0" or
+     * "false". A headless engine stops after the number of frames in the
+     * WZE_HEADLESS_FRAMES environment variable.
      * @warning This method must be called only once at the beginning of main.
      * @warning If the engine cannot be initialized, throws wze::exception.
      */
     static void initialize(std::string const& title, uint16_t width,
-                           uint16_t height);
+                           uint16_t height, bool headless = false);
 
     /**
      * @file engine.hpp
@@ -32,14 +32,19 @@
 #include <cstddef> /* IWYU pragma: export */
 #include <cstdint> /* IWYU pragma: export */
 #include <cstdlib> /* IWYU pragma: export */
+#include <cstring> /* IWYU pragma: export */
 
 #include <algorithm>     /* IWYU pragma: export */
 #include <array>         /* IWYU pragma: export */
+#include <chrono>        /* IWYU pragma: export */
+#include <deque>         /* IWYU pragma: export */
 #include <exception>     /* IWYU pragma: export */
 #include <filesystem>    /* IWYU pragma: export */
 #include <functional>    /* IWYU pragma: export */
+#include <future>        /* IWYU pragma: export */
 #include <limits>        /* IWYU pragma: export */
 #include <memory>        /* IWYU pragma: export */
+#include <numeric>       /* IWYU pragma: export */
 #include <optional>      /* IWYU pragma: export */
 #include <random>        /* IWYU pragma: export */
 #include <string>        /* IWYU pragma: export */
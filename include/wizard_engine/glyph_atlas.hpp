@@ -0,0 +1,142 @@
+/*
+  Wizard Engine
+  Copyright (C) 2023-2024 Zana Domán
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef WIZARD_ENGINE_GLYPH_ATLAS_HPP
+#define WIZARD_ENGINE_GLYPH_ATLAS_HPP
+
+#include <wizard_engine/assets.hpp>
+#include <wizard_engine/export.hpp>
+
+namespace wze {
+/**
+ * @file glyph_atlas.hpp
+ * @author Zana Domán
+ * @brief Glyph rasterized into a glyph atlas.
+ */
+struct glyph {
+    SDL_Rect source;
+    int32_t advance;
+};
+
+/**
+ * @file glyph_atlas.hpp
+ * @author Zana Domán
+ * @brief Texture atlas caching the rasterized glyphs of a font.
+ * @note A font is loaded with a fixed size and style, so one glyph atlas
+ * serves one font, size and style. Each glyph is rasterized and uploaded
+ * once, on its first use.
+ */
+class glyph_atlas final {
+  private:
+    static constexpr uint16_t _default_size = 1024;
+    std::shared_ptr<wze::font> _font;
+    std::shared_ptr<wze::texture> _texture;
+    uint16_t _size;
+    SDL_Point _cursor;
+    int32_t _shelf_height;
+    std::unordered_map<uint32_t, glyph> _glyphs;
+
+    /**
+     * @file glyph_atlas.hpp
+     * @author Zana Domán
+     * @brief Rasterizes a glyph and packs it into the texture.
+     * @param codepoint Code point of the glyph.
+     * @return Rasterized glyph.
+     * @warning If the glyph cannot be rasterized or the texture is full,
+     * throws wze::exception.
+     */
+    glyph const& insert(uint32_t codepoint);
+
+  public:
+    /**
+     * @file glyph_atlas.hpp
+     * @author Zana Domán
+     * @brief Returns the font of the glyph atlas.
+     * @return Font of the glyph atlas.
+     */
+    [[nodiscard]] std::shared_ptr<wze::font> const& font() const;
+
+    /**
+     * @file glyph_atlas.hpp
+     * @author Zana Domán
+     * @brief Returns the texture of the glyph atlas.
+     * @return Texture of the glyph atlas.
+     */
+    [[nodiscard]] std::shared_ptr<wze::texture> const& texture() const;
+
+    /**
+     * @file glyph_atlas.hpp
+     * @author Zana Domán
+     * @brief Returns the width and height of the texture.
+     * @return Width and height of the texture.
+     */
+    [[nodiscard]] uint16_t size() const;
+
+    /**
+     * @file glyph_atlas.hpp
+     * @author Zana Domán
+     * @brief Returns the number of glyphs in the glyph atlas.
+     * @return Number of glyphs in the glyph atlas.
+     */
+    [[nodiscard]] size_t glyphs() const;
+
+    /**
+     * @file glyph_atlas.hpp
+     * @author Zana Domán
+     * @brief Returns the distance between two lines of text.
+     * @return Distance between two lines of text.
+     */
+    [[nodiscard]] int32_t line_height() const;
+
+    /**
+     * @file glyph_atlas.hpp
+     * @author Zana Domán
+     * @brief Returns the kerning between two glyphs.
+     * @param previous Code point of the previous glyph.
+     * @param codepoint Code point of the glyph.
+     * @return Kerning between the glyphs.
+     */
+    [[nodiscard]] int32_t kerning(uint32_t previous, uint32_t codepoint) const;
+
+    /**
+     * @file glyph_atlas.hpp
+     * @author Zana Domán
+     * @brief Returns a glyph, rasterizing it on its first use.
+     * @param codepoint Code point of the glyph.
+     * @return Glyph of the code point.
+     * @warning If the glyph cannot be rasterized or the texture is full,
+     * throws wze::exception.
+     */
+    [[nodiscard]] glyph const& lookup(uint32_t codepoint);
+
+    /**
+     * @file glyph_atlas.hpp
+     * @author Zana Domán
+     * @param font Font of the glyph atlas.
+     * @param size Width and height of the texture.
+     * @warning If the texture cannot be created, throws wze::exception.
+     */
+    explicit glyph_atlas(std::shared_ptr<wze::font> const& font,
+                         uint16_t size = _default_size);
+};
+} /* namespace wze */
+
+#endif /* WIZARD_ENGINE_GLYPH_ATLAS_HPP */
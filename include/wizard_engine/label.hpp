@@ -0,0 +1,366 @@
+/*
+  Wizard Engine
+  Copyright (C) 2023-2024 Zana Domán
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef WIZARD_ENGINE_LABEL_HPP
+#define WIZARD_ENGINE_LABEL_HPP
+
+#include <wizard_engine/assets.hpp>
+#include <wizard_engine/enums.hpp>
+#include <wizard_engine/export.hpp>
+#include <wizard_engine/glyph_atlas.hpp>
+#include <wizard_engine/renderable.hpp>
+
+namespace wze {
+/**
+ * @file label.hpp
+ * @author Zana Domán
+ * @brief Renderable text laid out from the glyphs of a glyph atlas.
+ * @note The glyphs are rendered as the quads of a single render proxy, so
+ * changing the text only lays it out again, without rasterizing it or
+ * uploading a texture.
+ */
+class label final : public renderable {
+  private:
+    std::shared_ptr<glyph_atlas> _atlas;
+    std::shared_ptr<wze::texture> _texture;
+    std::string _text;
+    uint32_t _wrap_length;
+
+    /**
+     * @file label.hpp
+     * @author Zana Domán
+     * @brief Decodes an UTF-8 string into code points.
+     * @param text UTF-8 string.
+     * @return Code points of the string.
+     */
+    [[nodiscard]] static std::vector<uint32_t> decode(std::string const& text);
+
+    /**
+     * @file label.hpp
+     * @author Zana Domán
+     * @brief Lays out the text into the quads of the render proxy.
+     * @warning If a glyph cannot be rasterized, throws wze::exception.
+     */
+    void build();
+
+  public:
+    /**
+     * @file label.hpp
+     * @author Zana Domán
+     * @brief Returns the x position of the label.
+     * @return X position of the label.
+     */
+    [[nodiscard]] float x() const final;
+
+    /**
+     * @file label.hpp
+     * @author Zana Domán
+     * @brief Sets the x position of the label.
+     * @param x X position of the label.
+     */
+    void set_x(float x);
+
+    /**
+     * @file label.hpp
+     * @author Zana Domán
+     * @brief Returns the y position of the label.
+     * @return Y position of the label.
+     */
+    [[nodiscard]] float y() const final;
+
+    /**
+     * @file label.hpp
+     * @author Zana Domán
+     * @brief Sets the y position of the label.
+     * @param y Y position of the label.
+     */
+    void set_y(float y);
+
+    /**
+     * @file label.hpp
+     * @author Zana Domán
+     * @brief Returns the z position of the label.
+     * @return Z position of the label.
+     */
+    [[nodiscard]] float z() const final;
+
+    /**
+     * @file label.hpp
+     * @author Zana Domán
+     * @brief Sets the z position of the label.
+     * @param z Z position of the label.
+     */
+    void set_z(float z);
+
+    /**
+     * @file label.hpp
+     * @author Zana Domán
+     * @brief Returns the angle of the label.
+     * @return Angle of the label.
+     */
+    [[nodiscard]] float angle() const final;
+
+    /**
+     * @file label.hpp
+     * @author Zana Domán
+     * @brief Sets the angle of the label.
+     * @param angle Angle of the label.
+     */
+    void set_angle(float angle);
+
+    /**
+     * @file label.hpp
+     * @author Zana Domán
+     * @brief Returns the width of the label.
+     * @return Width of the label.
+     * @note Follows the layout of the text.
+     */
+    [[nodiscard]] float width() const final;
+
+    /**
+     * @file label.hpp
+     * @author Zana Domán
+     * @brief Returns the height of the label.
+     * @return Height of the label.
+     * @note Follows the layout of the text.
+     */
+    [[nodiscard]] float height() const final;
+
+    /**
+     * @file label.hpp
+     * @author Zana Domán
+     * @brief Returns whether the label is spatial or not.
+     * @return Whether the label is spatial or not.
+     */
+    [[nodiscard]] bool spatial() const final;
+
+    /**
+     * @file label.hpp
+     * @author Zana Domán
+     * @brief Sets whether the label is spatial or not.
+     * @param spatial Whether the label is spatial or not.
+     */
+    void set_spatial(bool spatial);
+
+    /**
+     * @file label.hpp
+     * @author Zana Domán
+     * @brief Returns the texture of the glyph atlas.
+     * @return Texture of the glyph atlas.
+     */
+    [[nodiscard]] std::shared_ptr<wze::texture> const& texture() const final;
+
+    /**
+     * @file label.hpp
+     * @author Zana Domán
+     * @brief Returns the red color modifier of the label.
+     * @return Red color modifier of the label.
+     */
+    [[nodiscard]] uint8_t color_r() const final;
+
+    /**
+     * @file label.hpp
+     * @author Zana Domán
+     * @brief Sets the red color modifier of the label.
+     * @param color_r Red color modifier of the label.
+     */
+    void set_color_r(uint8_t color_r);
+
+    /**
+     * @file label.hpp
+     * @author Zana Domán
+     * @brief Returns the green color modifier of the label.
+     * @return Green color modifier of the label.
+     */
+    [[nodiscard]] uint8_t color_g() const final;
+
+    /**
+     * @file label.hpp
+     * @author Zana Domán
+     * @brief Sets the green color modifier of the label.
+     * @param color_g Green color modifier of the label.
+     */
+    void set_color_g(uint8_t color_g);
+
+    /**
+     * @file label.hpp
+     * @author Zana Domán
+     * @brief Returns the blue color modifier of the label.
+     * @return Blue color modifier of the label.
+     */
+    [[nodiscard]] uint8_t color_b() const final;
+
+    /**
+     * @file label.hpp
+     * @author Zana Domán
+     * @brief Sets the blue color modifier of the label.
+     * @param color_b Blue color modifier of the label.
+     */
+    void set_color_b(uint8_t color_b);
+
+    /**
+     * @file label.hpp
+     * @author Zana Domán
+     * @brief Returns the alpha color modifier of the label.
+     * @return Alpha color modifier of the label.
+     */
+    [[nodiscard]] uint8_t color_a() const final;
+
+    /**
+     * @file label.hpp
+     * @author Zana Domán
+     * @brief Sets the alpha color modifier of the label.
+     * @param color_a Alpha color modifier of the label.
+     */
+    void set_color_a(uint8_t color_a);
+
+    /**
+     * @file label.hpp
+     * @author Zana Domán
+     * @brief Returns the flip of the label.
+     * @return Flip of the label.
+     */
+    [[nodiscard]] wze::flip flip() const final;
+
+    /**
+     * @file label.hpp
+     * @author Zana Domán
+     * @brief Sets the flip of the label.
+     * @param flip Flip of the label.
+     */
+    void set_flip(enum flip flip);
+
+    /**
+     * @file label.hpp
+     * @author Zana Domán
+     * @brief Returns the visibility of the label.
+     * @return Visibility of the label.
+     */
+    [[nodiscard]] bool visible() const final;
+
+    /**
+     * @file label.hpp
+     * @author Zana Domán
+     * @brief Sets the visibility of the label.
+     * @param visible Visibility of the label.
+     */
+    void set_visible(bool visible);
+
+    /**
+     * @file label.hpp
+     * @author Zana Domán
+     * @brief Returns the priority of the label.
+     * @return Priority of the label.
+     */
+    [[nodiscard]] uint8_t priority() const final;
+
+    /**
+     * @file label.hpp
+     * @author Zana Domán
+     * @brief Sets the priority of the label.
+     * @param priority Priority of the label.
+     */
+    void set_priority(uint8_t priority);
+
+    /**
+     * @file label.hpp
+     * @author Zana Domán
+     * @brief Returns the glyph atlas of the label.
+     * @return Glyph atlas of the label.
+     */
+    [[nodiscard]] std::shared_ptr<glyph_atlas> const& atlas() const;
+
+    /**
+     * @file label.hpp
+     * @author Zana Domán
+     * @brief Sets the glyph atlas of the label.
+     * @param atlas Glyph atlas of the label.
+     */
+    void set_atlas(std::shared_ptr<glyph_atlas> const& atlas);
+
+    /**
+     * @file label.hpp
+     * @author Zana Domán
+     * @brief Returns the text of the label.
+     * @return Text of the label.
+     */
+    [[nodiscard]] std::string const& text() const;
+
+    /**
+     * @file label.hpp
+     * @author Zana Domán
+     * @brief Sets the text of the label.
+     * @param text Text of the label.
+     * @note Setting the same text again has no effect.
+     */
+    void set_text(std::string const& text);
+
+    /**
+     * @file label.hpp
+     * @author Zana Domán
+     * @brief Returns the wrap length of the label.
+     * @return Wrap length of the label.
+     */
+    [[nodiscard]] uint32_t wrap_length() const;
+
+    /**
+     * @file label.hpp
+     * @author Zana Domán
+     * @brief Sets the wrap length of the label.
+     * @param wrap_length Wrap length of the label.
+     * @note 0 wrap length only wraps on newline characters.
+     */
+    void set_wrap_length(uint32_t wrap_length);
+
+    /**
+     * @file label.hpp
+     * @author Zana Domán
+     * @brief Constructs a label instance.
+     * @param x X position of the label.
+     * @param y Y position of the label.
+     * @param z Z position of the label.
+     * @param angle Angle of the label.
+     * @param spatial Whether the label is spatial or not.
+     * @param atlas Glyph atlas of the label.
+     * @param text Text of the label.
+     * @param wrap_length Wrap length of the label.
+     * @param color_r Red color modifier of the label.
+     * @param color_g Green color modifier of the label.
+     * @param color_b Blue color modifier of the label.
+     * @param color_a Alpha color modifier of the label.
+     * @param visible Visibility of the label.
+     * @param priority Priority of the label in the render queue.
+     * @warning If a glyph cannot be rasterized, throws wze::exception.
+     */
+    explicit label(float x = 0, float y = 0, float z = 0, float angle = 0,
+                   bool spatial = false,
+                   std::shared_ptr<glyph_atlas> const& atlas = {},
+                   std::string const& text = {}, uint32_t wrap_length = 0,
+                   uint8_t color_r = std::numeric_limits<uint8_t>::max(),
+                   uint8_t color_g = std::numeric_limits<uint8_t>::max(),
+                   uint8_t color_b = std::numeric_limits<uint8_t>::max(),
+                   uint8_t color_a = std::numeric_limits<uint8_t>::max(),
+                   bool visible = true,
+                   uint8_t priority = std::numeric_limits<uint8_t>::max() / 2);
+};
+} /* namespace wze */
+
+#endif /* WIZARD_ENGINE_LABEL_HPP */
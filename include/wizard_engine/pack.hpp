@@ -0,0 +1,133 @@
+/*
+  Wizard Engine
+  Copyright (C) 2023-2024 Zana Domán
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef WIZARD_ENGINE_PACK_HPP
+#define WIZARD_ENGINE_PACK_HPP
+
+#include <wizard_engine/export.hpp>
+
+namespace wze {
+/**
+ * @file pack.hpp
+ * @author Zana Domán
+ * @brief Read-only archive of assets mapped into memory.
+ * @note A pack starts with the magic "WZEPACK", a zero byte and the number
+ * of assets, followed by the index of the assets sorted by the 64 bit FNV-1a
+ * hash of their paths, then the paths and the contents. Every field is a
+ * little endian 64 bit unsigned integer. Packs are built by the pack tool of
+ * the repository.
+ */
+class pack final {
+  private:
+    /**
+     * @file pack.hpp
+     * @author Zana Domán
+     * @brief Index entry of an asset.
+     */
+    struct entry {
+        uint64_t hash;
+        uint64_t path_offset;
+        uint64_t path_size;
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    static constexpr std::array<char, 8> _magic = {'W', 'Z', 'E', 'P',
+                                                   'A', 'C', 'K', '\0'};
+    std::unique_ptr<uint8_t const, std::function<void(uint8_t const*)>> _data;
+    size_t _size;
+    uint64_t _count;
+
+    /**
+     * @file pack.hpp
+     * @author Zana Domán
+     * @brief Reads an index entry.
+     * @param index Index of the entry.
+     * @return Index entry.
+     */
+    [[nodiscard]] entry read(uint64_t index) const;
+
+  public:
+    /**
+     * @file pack.hpp
+     * @author Zana Domán
+     * @brief Returns the hash of a path.
+     * @param path Normalized path.
+     * @return 64 bit FNV-1a hash of the path.
+     */
+    [[nodiscard]] static uint64_t hash(std::string const& path);
+
+    /**
+     * @file pack.hpp
+     * @author Zana Domán
+     * @brief Returns the normalized form of a path inside a pack.
+     * @param path Path relative to the assets directory.
+     * @return Normalized path with forward slashes.
+     */
+    [[nodiscard]] static std::string normalize(std::string const& path);
+
+    /**
+     * @file pack.hpp
+     * @author Zana Domán
+     * @brief Returns whether the pack contains an asset or not.
+     * @param path Path relative to the assets directory.
+     * @return Whether the pack contains the asset or not.
+     */
+    [[nodiscard]] bool contains(std::string const& path) const;
+
+    /**
+     * @file pack.hpp
+     * @author Zana Domán
+     * @brief Returns the contents of an asset of the pack.
+     * @param path Path relative to the assets directory.
+     * @return Contents and size of the asset, null if it is not in the pack.
+     * @note The contents refer to the memory of the pack, they must not
+     * outlive the pack.
+     */
+    [[nodiscard]] std::pair<uint8_t const*, size_t>
+    view(std::string const& path) const;
+
+    /**
+     * @file pack.hpp
+     * @author Zana Domán
+     * @brief Opens an asset of the pack without copying it.
+     * @param path Path relative to the assets directory.
+     * @return Read-only stream of the asset, null if it is not in the pack.
+     * @note The stream refers to the memory of the pack, it must not outlive
+     * the pack.
+     */
+    [[nodiscard]] SDL_RWops* open(std::string const& path) const;
+
+    /**
+     * @file pack.hpp
+     * @author Zana Domán
+     * @brief Maps a pack into memory.
+     * @param path Path to the pack.
+     * @note The pack is memory-mapped on Linux, elsewhere it is read into
+     * memory once, as Android assets and the web preload are not files.
+     * @warning If the pack cannot be mapped or is malformed, throws
+     * wze::exception.
+     */
+    explicit pack(std::string const& path);
+};
+} /* namespace wze */
+
+#endif /* WIZARD_ENGINE_PACK_HPP */
@@ -0,0 +1,561 @@
+/*
+  Wizard Engine
+  Copyright (C) 2023-2024 Zana Domán
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef WIZARD_ENGINE_PARTICLE_EMITTER_HPP
+#define WIZARD_ENGINE_PARTICLE_EMITTER_HPP
+
+#include <wizard_engine/assets.hpp>
+#include <wizard_engine/enums.hpp>
+#include <wizard_engine/export.hpp>
+#include <wizard_engine/renderable.hpp>
+
+namespace wze {
+/**
+ * @file particle_emitter.hpp
+ * @author Zana Domán
+ * @brief Renderable emitting particles.
+ * @note The particles are stored as structure of arrays and rendered as the
+ * quads of a single render proxy, so the particle emitter is sorted as one
+ * unit and its particles are drawn with a single draw call.
+ */
+class particle_emitter final : public renderable {
+  private:
+    std::shared_ptr<wze::texture> _texture;
+    size_t _capacity;
+    float _rate;
+    float _lifetime;
+    float _speed;
+    float _spread;
+    float _acceleration_x;
+    float _acceleration_y;
+    float _start_size;
+    float _end_size;
+    SDL_Color _start_color;
+    SDL_Color _end_color;
+    float _emission;
+    std::vector<float> _particle_x;
+    std::vector<float> _particle_y;
+    std::vector<float> _velocity_x;
+    std::vector<float> _velocity_y;
+    std::vector<float> _age;
+    size_t _head;
+    std::vector<float> _progress;
+    std::vector<float> _size;
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Expires the oldest particles.
+     * @param count Number of expired particles.
+     * @note Expired particles are skipped by advancing the head, they are only
+     * erased once they outnumber the living particles.
+     */
+    void expire(size_t count);
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Emits new particles at the position of the particle emitter.
+     * @param count Number of emitted particles.
+     */
+    void emit(size_t count);
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Rebuilds the quads of the particles and the area enclosing
+     * them.
+     * @note The quads are rebuilt in place unless a pending frame still
+     * refers to them. The progress and the size of the particles are
+     * computed in their own passes before the quads are filled.
+     */
+    void build();
+
+  public:
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Returns the x position of the particle emitter.
+     * @return X position of the particle emitter.
+     */
+    [[nodiscard]] float x() const final;
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Sets the x position of the particle emitter.
+     * @param x X position of the particle emitter.
+     */
+    void set_x(float x);
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Returns the y position of the particle emitter.
+     * @return Y position of the particle emitter.
+     */
+    [[nodiscard]] float y() const final;
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Sets the y position of the particle emitter.
+     * @param y Y position of the particle emitter.
+     */
+    void set_y(float y);
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Returns the z position of the particle emitter.
+     * @return Z position of the particle emitter.
+     */
+    [[nodiscard]] float z() const final;
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Sets the z position of the particle emitter.
+     * @param z Z position of the particle emitter.
+     */
+    void set_z(float z);
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Returns the angle of the particle emitter.
+     * @return Angle of the particle emitter.
+     */
+    [[nodiscard]] float angle() const final;
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Sets the angle of the particle emitter.
+     * @param angle Angle of the particle emitter.
+     * @note The particles are emitted in the direction of the angle.
+     */
+    void set_angle(float angle);
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Returns the width of the area of the particles.
+     * @return Width of the area of the particles.
+     * @note Follows the particles at every update.
+     */
+    [[nodiscard]] float width() const final;
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Returns the height of the area of the particles.
+     * @return Height of the area of the particles.
+     * @note Follows the particles at every update.
+     */
+    [[nodiscard]] float height() const final;
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Returns whether the particle emitter is spatial or not.
+     * @return Whether the particle emitter is spatial or not.
+     */
+    [[nodiscard]] bool spatial() const final;
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Sets whether the particle emitter is spatial or not.
+     * @param spatial Whether the particle emitter is spatial or not.
+     */
+    void set_spatial(bool spatial);
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Returns the texture of the particles.
+     * @return Texture of the particles.
+     */
+    [[nodiscard]] std::shared_ptr<wze::texture> const& texture() const final;
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Sets the texture of the particles.
+     * @param texture Texture of the particles.
+     */
+    void set_texture(std::shared_ptr<wze::texture> const& texture);
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Returns the red color modifier of the particles.
+     * @return Red color modifier of the particles.
+     */
+    [[nodiscard]] uint8_t color_r() const final;
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Sets the red color modifier of the particles.
+     * @param color_r Red color modifier of the particles.
+     */
+    void set_color_r(uint8_t color_r);
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Returns the green color modifier of the particles.
+     * @return Green color modifier of the particles.
+     */
+    [[nodiscard]] uint8_t color_g() const final;
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Sets the green color modifier of the particles.
+     * @param color_g Green color modifier of the particles.
+     */
+    void set_color_g(uint8_t color_g);
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Returns the blue color modifier of the particles.
+     * @return Blue color modifier of the particles.
+     */
+    [[nodiscard]] uint8_t color_b() const final;
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Sets the blue color modifier of the particles.
+     * @param color_b Blue color modifier of the particles.
+     */
+    void set_color_b(uint8_t color_b);
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Returns the alpha color modifier of the particles.
+     * @return Alpha color modifier of the particles.
+     */
+    [[nodiscard]] uint8_t color_a() const final;
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Sets the alpha color modifier of the particles.
+     * @param color_a Alpha color modifier of the particles.
+     */
+    void set_color_a(uint8_t color_a);
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Returns whether the particles are flipped on one of their axes.
+     * @return Whether the particles are flipped on one of their axes.
+     */
+    [[nodiscard]] wze::flip flip() const final;
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Sets whether the particles are flipped on one of their axes.
+     * @param flip Whether the particles are flipped on one of their axes.
+     */
+    void set_flip(enum flip flip);
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Returns the visibility of the particle emitter.
+     * @return Visibility of the particle emitter.
+     */
+    [[nodiscard]] bool visible() const final;
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Sets the visibility of the particle emitter.
+     * @param visible Visibility of the particle emitter.
+     */
+    void set_visible(bool visible);
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Returns the priority of the particle emitter in the render queue.
+     * @return Priority of the particle emitter in the render queue.
+     */
+    [[nodiscard]] uint8_t priority() const final;
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Sets the priority of the particle emitter in the render queue.
+     * @param priority Priority of the particle emitter in the render queue.
+     */
+    void set_priority(uint8_t priority);
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Returns the maximum number of particles.
+     * @return Maximum number of particles.
+     */
+    [[nodiscard]] size_t capacity() const;
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Sets the maximum number of particles.
+     * @param capacity Maximum number of particles.
+     * @note Particles over the capacity are expired.
+     */
+    void set_capacity(size_t capacity);
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Returns the number of particles emitted per second.
+     * @return Number of particles emitted per second.
+     */
+    [[nodiscard]] float rate() const;
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Sets the number of particles emitted per second.
+     * @param rate Number of particles emitted per second.
+     */
+    void set_rate(float rate);
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Returns the lifetime of the particles in milliseconds.
+     * @return Lifetime of the particles in milliseconds.
+     */
+    [[nodiscard]] float lifetime() const;
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Sets the lifetime of the particles in milliseconds.
+     * @param lifetime Lifetime of the particles in milliseconds.
+     */
+    void set_lifetime(float lifetime);
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Returns the initial speed of the particles.
+     * @return Initial speed of the particles.
+     */
+    [[nodiscard]] float speed() const;
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Sets the initial speed of the particles.
+     * @param speed Initial speed of the particles.
+     */
+    void set_speed(float speed);
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Returns the angle of the cone the particles are emitted in.
+     * @return Angle of the cone the particles are emitted in.
+     */
+    [[nodiscard]] float spread() const;
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Sets the angle of the cone the particles are emitted in.
+     * @param spread Angle of the cone the particles are emitted in.
+     */
+    void set_spread(float spread);
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Returns the x component of the acceleration of the particles.
+     * @return X component of the acceleration of the particles.
+     */
+    [[nodiscard]] float acceleration_x() const;
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Sets the x component of the acceleration of the particles.
+     * @param acceleration_x X component of the acceleration of the particles.
+     */
+    void set_acceleration_x(float acceleration_x);
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Returns the y component of the acceleration of the particles.
+     * @return Y component of the acceleration of the particles.
+     */
+    [[nodiscard]] float acceleration_y() const;
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Sets the y component of the acceleration of the particles.
+     * @param acceleration_y Y component of the acceleration of the particles.
+     */
+    void set_acceleration_y(float acceleration_y);
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Returns the size of the particles when they are emitted.
+     * @return Size of the particles when they are emitted.
+     */
+    [[nodiscard]] float start_size() const;
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Sets the size of the particles when they are emitted.
+     * @param start_size Size of the particles when they are emitted.
+     */
+    void set_start_size(float start_size);
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Returns the size of the particles when they expire.
+     * @return Size of the particles when they expire.
+     */
+    [[nodiscard]] float end_size() const;
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Sets the size of the particles when they expire.
+     * @param end_size Size of the particles when they expire.
+     */
+    void set_end_size(float end_size);
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Returns the color of the particles when they are emitted.
+     * @return Color of the particles when they are emitted.
+     */
+    [[nodiscard]] SDL_Color const& start_color() const;
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Sets the color of the particles when they are emitted.
+     * @param start_color Color of the particles when they are emitted.
+     */
+    void set_start_color(SDL_Color const& start_color);
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Returns the color of the particles when they expire.
+     * @return Color of the particles when they expire.
+     */
+    [[nodiscard]] SDL_Color const& end_color() const;
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Sets the color of the particles when they expire.
+     * @param end_color Color of the particles when they expire.
+     */
+    void set_end_color(SDL_Color const& end_color);
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Returns the number of living particles.
+     * @return Number of living particles.
+     */
+    [[nodiscard]] size_t particles() const;
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Emits, moves and expires the particles by the delta time, then
+     * fades them and rebuilds their quads.
+     * @note Must be called once per frame, after the particle emitter is moved.
+     */
+    void update();
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Expires every particle.
+     */
+    void clear();
+
+    /**
+     * @file particle_emitter.hpp
+     * @author Zana Domán
+     * @brief Constructs a particle emitter instance.
+     * @param x X position of the particle emitter.
+     * @param y Y position of the particle emitter.
+     * @param z Z position of the particle emitter.
+     * @param angle Angle of the particle emitter.
+     * @param spatial Whether the particle emitter is spatial or not.
+     * @param texture Texture of the particles.
+     * @param capacity Maximum number of particles.
+     * @param rate Number of particles emitted per second.
+     * @param lifetime Lifetime of the particles in milliseconds.
+     * @param speed Initial speed of the particles.
+     * @param spread Angle of the cone the particles are emitted in.
+     * @param start_size Size of the particles when they are emitted.
+     * @param end_size Size of the particles when they expire.
+     * @param start_color Color of the particles when they are emitted.
+     * @param end_color Color of the particles when they expire.
+     * @param visible Visibility of the particle emitter.
+     * @param priority Priority of the particle emitter in the render queue.
+     */
+    explicit particle_emitter(
+        float x = 0, float y = 0, float z = 0, float angle = 0,
+        bool spatial = false, std::shared_ptr<wze::texture> const& texture = {},
+        size_t capacity = std::numeric_limits<uint16_t>::max(), float rate = 0,
+        float lifetime = 0, float speed = 0, float spread = 0,
+        float start_size = 0, float end_size = 0,
+        SDL_Color const& start_color = {std::numeric_limits<uint8_t>::max(),
+                                        std::numeric_limits<uint8_t>::max(),
+                                        std::numeric_limits<uint8_t>::max(),
+                                        std::numeric_limits<uint8_t>::max()},
+        SDL_Color const& end_color = {std::numeric_limits<uint8_t>::max(),
+                                      std::numeric_limits<uint8_t>::max(),
+                                      std::numeric_limits<uint8_t>::max(), 0},
+        bool visible = true,
+        uint8_t priority = std::numeric_limits<uint8_t>::max() / 2);
+};
+} /* namespace wze */
+
+#endif /* WIZARD_ENGINE_PARTICLE_EMITTER_HPP */
@@ -27,26 +27,218 @@
 #include <wizard_engine/export.hpp>
 
 namespace wze {
+class renderable;
+
+/**
+ * @file renderable.hpp
+ * @author Zana Domán
+ * @brief Quad drawn in place of the area of a renderable instance.
+ * @note The position of the quad is relative to the center of the
+ * renderable instance, the quad is scaled together with it. The source of
+ * the quad is given in texture coordinates ranging from 0 to 1.
+ */
+struct render_quad {
+    float x;
+    float y;
+    float width;
+    float height;
+    float angle;
+    SDL_Color color;
+    SDL_FRect source;
+};
+
+/**
+ * @file renderable.hpp
+ * @author Zana Domán
+ * @brief Render state of the renderable instances stored as structure of
+ * arrays indexed by render proxies.
+ */
+struct render_proxies {
+    std::vector<renderable*> owner;
+    std::vector<size_t> serial;
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> z;
+    std::vector<float> angle;
+    std::vector<float> width;
+    std::vector<float> height;
+    std::vector<uint8_t> spatial;
+    std::vector<wze::texture*> texture;
+    std::vector<SDL_FRect> source;
+    std::vector<SDL_Color> color;
+    std::vector<uint8_t> flip;
+    std::vector<uint8_t> visible;
+    std::vector<uint8_t> priority;
+    std::vector<uint8_t> polled;
+    std::vector<uint8_t> invalid;
+    std::vector<uint8_t> displaced;
+    std::vector<uint64_t> queued;
+    std::vector<uint64_t> cell;
+    std::vector<size_t> frame;
+    std::vector<uint8_t> drawn;
+    std::vector<SDL_FRect> screen_area;
+    std::vector<float> screen_angle;
+    std::vector<std::shared_ptr<std::vector<render_quad>>> quads;
+};
+
 /**
  * @file renderable.hpp
  * @author Zana Domán
  * @brief Interface to make an object renderable.
+ * @note The renderer reads the render state of the object from its render
+ * proxy instead of calling the getters. Implementations constructed with the
+ * default constructor are polled: their getters are copied into the render
+ * proxy once per frame, so implementations written against the getters keep
+ * rendering. Implementations writing their render proxy directly opt out of
+ * polling with the protected constructor.
  */
 class renderable {
   private:
-    static std::vector<renderable*> _instances;
-    SDL_FRect _screen_area;
-    float _screen_angle;
+    static render_proxies _proxies;
+    static std::vector<size_t> _released;
+    static std::vector<size_t> _retired;
+    static std::vector<size_t> _invalidated;
+    static std::vector<size_t> _displaced;
+    static size_t _serials;
+    static size_t _polled;
+    size_t _proxy;
+
+    /**
+     * @file renderable.hpp
+     * @author Zana Domán
+     * @brief Acquires a render proxy.
+     * @return Acquired render proxy.
+     */
+    [[nodiscard]] static size_t acquire();
+
+    /**
+     * @file renderable.hpp
+     * @author Zana Domán
+     * @brief Releases a render proxy.
+     * @param proxy Released render proxy.
+     * @note The released render proxy stays invalidated until the next
+     * validation, so the renderer drops it from the render queues and the
+     * spatial grid before it is reacquired.
+     */
+    static void release(size_t proxy);
+
+    /**
+     * @file renderable.hpp
+     * @author Zana Domán
+     * @brief Copies the changed getters of the object into its render proxy
+     * and invalidates what they affect.
+     */
+    void refresh();
+
+  protected:
+    /**
+     * @file renderable.hpp
+     * @author Zana Domán
+     * @brief Constructs a renderable instance and pushes into instances.
+     * @param polled Whether the render proxy is filled from the getters in
+     * every frame.
+     * @note Implementations writing their render proxy directly pass false.
+     */
+    explicit renderable(bool polled);
+
+    /**
+     * @file renderable.hpp
+     * @author Zana Domán
+     * @brief Invalidates the position of the object in the render queue.
+     * @note Must be called whenever the z position, the spatiality, the
+     * visibility or the priority of the object changes.
+     */
+    void invalidate();
+
+    /**
+     * @file renderable.hpp
+     * @author Zana Domán
+     * @brief Invalidates the bounds of the object in the spatial grid.
+     * @note Must be called whenever the x or y position, the width or the
+     * height of the object changes.
+     */
+    void displace();
+
+    /**
+     * @file renderable.hpp
+     * @author Zana Domán
+     * @brief Invalidates the appearance of the object on a retained layer.
+     * @note Must be called whenever the angle, the texture, the color
+     * modifiers or the flip of the object changes.
+     */
+    void redraw();
+
+    /**
+     * @file renderable.hpp
+     * @author Zana Domán
+     * @brief Copies the render state of the object into its render proxy.
+     * @note Implementations not writing their render proxy directly must call
+     * this method whenever their render state changes.
+     */
+    void synchronize();
 
   public:
 #ifdef __WIZARD_ENGINE_INTERNAL__
     /**
      * @file renderable.hpp
      * @author Zana Domán
-     * @brief Returns the renderable instances.
-     * @return Renderable instances.
+     * @brief Returns the render proxies.
+     * @return Render proxies.
+     */
+    [[nodiscard]] static render_proxies& proxies();
+#endif /* __WIZARD_ENGINE_INTERNAL__ */
+
+#ifdef __WIZARD_ENGINE_INTERNAL__
+    /**
+     * @file renderable.hpp
+     * @author Zana Domán
+     * @brief Returns the render proxies invalidated since the last
+     * validation.
+     * @return Invalidated render proxies.
+     */
+    [[nodiscard]] static std::vector<size_t> const& invalidated();
+#endif /* __WIZARD_ENGINE_INTERNAL__ */
+
+#ifdef __WIZARD_ENGINE_INTERNAL__
+    /**
+     * @file renderable.hpp
+     * @author Zana Domán
+     * @brief Returns the render proxies displaced since the last validation.
+     * @return Displaced render proxies.
+     * @note Includes the invalidated render proxies.
      */
-    [[nodiscard]] static std::vector<renderable*> const& instances();
+    [[nodiscard]] static std::vector<size_t> const& displaced();
+#endif /* __WIZARD_ENGINE_INTERNAL__ */
+
+#ifdef __WIZARD_ENGINE_INTERNAL__
+    /**
+     * @file renderable.hpp
+     * @author Zana Domán
+     * @brief Copies the getters of the polled objects into their render
+     * proxies.
+     */
+    static void poll();
+#endif /* __WIZARD_ENGINE_INTERNAL__ */
+
+#ifdef __WIZARD_ENGINE_INTERNAL__
+    /**
+     * @file renderable.hpp
+     * @author Zana Domán
+     * @brief Validates the invalidated and displaced render proxies.
+     * @note The render proxies released since the last validation become
+     * reacquirable.
+     */
+    static void validate();
+#endif /* __WIZARD_ENGINE_INTERNAL__ */
+
+#ifdef __WIZARD_ENGINE_INTERNAL__
+    /**
+     * @file renderable.hpp
+     * @author Zana Domán
+     * @brief Returns the render proxy of the object.
+     * @return Render proxy of the object.
+     */
+    [[nodiscard]] size_t proxy() const;
 #endif /* __WIZARD_ENGINE_INTERNAL__ */
 
     /**
@@ -57,6 +249,17 @@ class renderable {
      */
     [[nodiscard]] SDL_FRect const& screen_area() const;
 
+    /**
+     * @file renderable.hpp
+     * @author Zana Domán
+     * @brief Returns the drawn region of the texture of the object.
+     * @return Drawn region of the texture in texture coordinates ranging from
+     * 0 to 1.
+     * @note The sources of the render quads of the object are relative to
+     * this region.
+     */
+    [[nodiscard]] SDL_FRect const& source() const;
+
 #ifdef __WIZARD_ENGINE_INTERNAL__
     /**
      * @file renderable.hpp
@@ -210,7 +413,9 @@ class renderable {
     /**
      * @file renderable.hpp
      * @author Zana Domán
-     * @brief Constructs a renderable instance and pushes into instances.
+     * @brief Constructs a polled renderable instance and pushes into
+     * instances.
+     * @note The instance is queued for rendering at the next frame.
      */
     renderable();
 
@@ -225,7 +430,8 @@ class renderable {
     /**
      * @file renderable.hpp
      * @author Zana Domán
-     * @brief Destroys the renderable instance and erases from instances.
+     * @brief Destroys the renderable instance and erases from instances and
+     * the render queue.
      */
     virtual ~renderable();
 
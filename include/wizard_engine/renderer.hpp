@@ -23,10 +23,41 @@
 #define WIZARD_ENGINE_RENDERER_HPP
 
 #include <wizard_engine/assets.hpp>
+#include <wizard_engine/camera.hpp>
 #include <wizard_engine/export.hpp>
 #include <wizard_engine/renderable.hpp>
 
 namespace wze {
+/**
+ * @file renderer.hpp
+ * @author Zana Domán
+ * @brief Statistics of a layer in a frame.
+ */
+struct layer_stats {
+    size_t considered;
+    size_t invisible;
+    size_t culled;
+    size_t drawn;
+};
+
+/**
+ * @file renderer.hpp
+ * @author Zana Domán
+ * @brief Statistics of the renderer in a frame.
+ * @note Times are measured in milliseconds.
+ */
+struct render_stats {
+    layer_stats space;
+    layer_stats plane;
+    size_t calls;
+    size_t switches;
+    float sort_time;
+    float open_frame_time;
+    float open_space_time;
+    float open_plane_time;
+    float close_frame_time;
+};
+
 /**
  * @file renderer.hpp
  * @author Zana Domán, Gunics Roland
@@ -34,6 +65,144 @@ namespace wze {
  */
 class renderer final {
   private:
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Render queue entry of a renderable instance.
+     */
+    struct entry {
+        uint64_t key;
+        size_t serial;
+        size_t proxy;
+    };
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Spatial grid cell of spatial render proxies.
+     */
+    struct cell {
+        std::vector<size_t> proxies;
+        float radius;
+    };
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Draw call of consecutive vertices sharing a texture.
+     */
+    struct batch {
+        wze::texture* texture;
+        size_t first;
+        size_t count;
+    };
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Part of a frame prepared by a single worker.
+     */
+    struct slice {
+        std::vector<SDL_Vertex> vertices;
+        std::vector<batch> space;
+        std::vector<batch> plane;
+        std::vector<std::pair<size_t, size_t>> tie;
+        std::unordered_map<wze::texture*, size_t> ranks;
+        layer_stats space_stats;
+        layer_stats plane_stats;
+    };
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Frame captured for preparation and submission.
+     */
+    struct frame {
+        render_proxies snapshot;
+        render_proxies* proxies;
+        std::vector<size_t> space;
+        std::vector<size_t> plane;
+        camera_view view;
+        float origo_x;
+        float origo_y;
+        size_t stamp;
+        bool redraw;
+        std::vector<slice> slices;
+    };
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Positions of the render proxies at the previous simulation tick.
+     */
+    struct pose {
+        std::vector<size_t> serial;
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> angle;
+    };
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Render pass of a layer in the current frame.
+     */
+    enum pass : uint8_t {
+        PASS_NONE,
+        PASS_DIRECT,
+        PASS_TARGET,
+    };
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Side length of the spatial grid cells.
+     */
+    static constexpr float _cell_size = 1024;
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Spatial grid cell of renderable instances outside the grid.
+     */
+    static constexpr uint64_t _no_cell = std::numeric_limits<uint64_t>::max();
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Render queue key of render proxies outside the render queues.
+     */
+    static constexpr uint64_t _no_key = std::numeric_limits<uint64_t>::max();
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Render proxy of render queue entries erased from the render
+     * queues.
+     */
+    static constexpr size_t _no_proxy = std::numeric_limits<size_t>::max();
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Maximum number of workers preparing the frames.
+     */
+    static constexpr size_t _max_workers = 4;
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Lowest resolution scale of the space.
+     */
+    static constexpr float _min_resolution_scale = .5;
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Step of the resolution scale of the space.
+     */
+    static constexpr float _resolution_step = .05;
+
     static float _origo_x;
     static float _origo_y;
     static SDL_Renderer* _base;
@@ -48,11 +217,41 @@ class renderer final {
     static uint8_t _space_color_a;
     static std::shared_ptr<texture> _space_texture;
     static SDL_FRect _space_area;
+    static float _resolution_scale;
+    static float _resolution_budget;
+    static float _submit_time;
     static std::unique_ptr<texture, std::function<void(texture*)>> _plane;
     static uint8_t _plane_color_r;
     static uint8_t _plane_color_g;
     static uint8_t _plane_color_b;
     static uint8_t _plane_color_a;
+    static bool _plane_retained;
+    static bool _plane_invalid;
+    static size_t _plane_reuses;
+    static size_t _plane_redraws;
+    static pass _space_pass;
+    static pass _plane_pass;
+    static std::vector<int32_t> _indices;
+    static std::vector<entry> _space_queue;
+    static std::vector<entry> _plane_queue;
+    static std::unordered_map<uint64_t, cell> _grid;
+    static size_t _frame;
+    static std::array<frame, 2> _frames;
+    static size_t _current;
+    static bool _pending;
+    static bool _pipelined;
+    static size_t _workers;
+    static SDL_sem* _start;
+    static SDL_sem* _phase;
+    static SDL_sem* _done;
+    static SDL_atomic_t _arrived;
+    static std::vector<texture*> _released;
+    static std::unordered_map<texture*, SDL_Color> _modulations;
+    static render_stats _stats;
+    static bool _readback;
+    static std::shared_ptr<image> _screenshot;
+    static pose _previous;
+    static float _interpolation;
 
     /**
      * @file renderer.hpp
@@ -61,6 +260,306 @@ class renderer final {
      */
     renderer() = default;
 
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Encodes a z position and a priority into a render queue key.
+     * @param z Z position of the renderable instance.
+     * @param priority Priority of the renderable instance.
+     * @return Render queue key, ascending with descending z positions, then
+     * with ascending priorities.
+     */
+    [[nodiscard]] static uint64_t key(float z, uint8_t priority);
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Returns a byte of the sort order of a render queue entry.
+     * @param entry Render queue entry.
+     * @param position Position of the byte, starting from the least
+     * significant byte of the serial number.
+     * @return Byte of the sort order of the render queue entry.
+     */
+    [[nodiscard]] static uint8_t digit(entry const& entry, size_t position);
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Sorts render queue entries with a stable LSD radix sort.
+     * @param entries Sorted render queue entries.
+     * @note Bytes shared by every entry are skipped, so the entries of the
+     * plane are sorted by a single 256 bucket counting pass on their
+     * priorities besides their serial numbers.
+     */
+    static void radix(std::vector<entry>& entries);
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Returns whether a render queue entry precedes another or not.
+     * @param entry1 First render queue entry.
+     * @param entry2 Second render queue entry.
+     * @return Whether the first render queue entry precedes the second or
+     * not.
+     */
+    [[nodiscard]] static bool precedes(entry const& entry1,
+                                       entry const& entry2);
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Repairs the render queues by requeuing the invalidated render
+     * proxies, invalidates the plane if any of them belongs to it.
+     * @note The queued entries of the invalidated render proxies are found by
+     * binary search, so only the tails of the render queues behind the first
+     * changed entry are compacted and merged. Displaced render proxies are
+     * left to relocate.
+     */
+    static void requeue();
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Returns the spatial grid cell of a spatial position.
+     * @param x X component of the spatial position.
+     * @param y Y component of the spatial position.
+     * @param z Z component of the spatial position.
+     * @return Spatial grid cell of the spatial position.
+     */
+    [[nodiscard]] static uint64_t locate(float x, float y, float z);
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Erases a render proxy from its spatial grid cell.
+     * @param proxy Render proxy.
+     */
+    static void leave(size_t proxy);
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Repairs the spatial grid by relocating the displaced render
+     * proxies, invalidates the plane if any of them belongs to it.
+     */
+    static void relocate();
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Marks the render proxies of the spatial grid cells inside the
+     * view frustum with the current frame.
+     * @note Cells are tested against the circle enclosing the screen, scaled
+     * by the depth of their farthest edge, so the test is conservative.
+     */
+    static void cull();
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Captures the render state of a new frame.
+     * @param frame Captured frame.
+     * @param slices Number of slices to prepare the frame in.
+     * @note When pipelined or interpolated, the render proxies are copied,
+     * otherwise the live ones are prepared.
+     */
+    static void capture(frame& frame, size_t slices);
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Interpolates the captured render proxies between the previous
+     * and the current simulation tick.
+     * @param proxies Captured render proxies.
+     * @note Render proxies acquired since the previous tick are not
+     * interpolated.
+     */
+    static void blend(render_proxies& proxies);
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán, Gunics Roland
+     * @brief Returns the visibility of a render proxy.
+     * @param frame Frame of the render proxy.
+     * @param proxy Render proxy.
+     * @return Visibility of the render proxy.
+     */
+    [[nodiscard]] static bool invisible(frame const& frame, size_t proxy);
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Returns whether a render proxy is outside the view frustum or
+     * not.
+     * @param frame Frame of the render proxy.
+     * @param proxy Render proxy.
+     * @return Whether the render proxy is outside the view frustum or not.
+     * @note Only spatial render proxies can be outside the view frustum.
+     */
+    [[nodiscard]] static bool culled(frame const& frame, size_t proxy);
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán, Gunics Roland
+     * @brief Transforms a render proxy.
+     * @param frame Frame of the render proxy.
+     * @param proxy Render proxy.
+     */
+    static void transform(frame& frame, size_t proxy);
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Returns whether a render proxy is inside the bounds of the
+     * screen or not.
+     * @param frame Frame of the render proxy.
+     * @param proxy Render proxy.
+     * @return Whether the render proxy is inside the bounds of the screen or
+     * not.
+     */
+    [[nodiscard]] static bool offscreen(frame const& frame, size_t proxy);
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Culls, projects and transforms a slice of the render proxies of a
+     * frame, projecting them in batches, then marks the ones to be drawn and
+     * collects the statistics of the slice.
+     * @param frame Prepared frame.
+     * @param index Index of the slice.
+     */
+    static void prepare(frame& frame, size_t index);
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Appends the vertices of a rotated rectangle to a slice.
+     * @param slice Slice holding the vertices.
+     * @param center Center of the rectangle.
+     * @param half_width Half of the width of the rectangle.
+     * @param half_height Half of the height of the rectangle.
+     * @param transformation_matrix Rotation of the rectangle.
+     * @param color Color of the vertices.
+     * @param source Texture coordinates of the rectangle.
+     * @param flip Flip of the texture coordinates.
+     */
+    static void emit(slice& slice, SDL_FPoint const& center, float half_width,
+                     float half_height,
+                     std::array<float, 4> const& transformation_matrix,
+                     SDL_Color const& color, SDL_FRect const& source,
+                     uint8_t flip);
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Appends the vertices of a render proxy to a batch list.
+     * @param frame Frame of the render proxy.
+     * @param slice Slice holding the vertices.
+     * @param batches Batch list of the layer.
+     * @param proxy Render proxy.
+     * @note Consecutive render proxies sharing a texture are rendered with a
+     * single draw call. Render proxies with quads are drawn as their quads.
+     */
+    static void render(frame const& frame, slice& slice,
+                       std::vector<batch>& batches, size_t proxy);
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Appends the vertices of render proxies tied in the render queue
+     * to a batch list, grouped by their textures.
+     * @param frame Frame of the render proxies.
+     * @param slice Slice holding the vertices.
+     * @param batches Batch list of the layer.
+     * @param first First tied render proxy.
+     * @param last End of the tied render proxies.
+     * @note Tied render proxies have the same z position and priority, so
+     * their order is unspecified. The groups follow the first appearance of
+     * their textures to keep the order deterministic.
+     */
+    static void group(frame const& frame, slice& slice,
+                      std::vector<batch>& batches,
+                      std::vector<size_t>::const_iterator first,
+                      std::vector<size_t>::const_iterator last);
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Builds the batch lists of a slice of the render queues of a
+     * frame.
+     * @param frame Prepared frame.
+     * @param index Index of the slice.
+     */
+    static void build(frame& frame, size_t index);
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Prepares slices of the captured frames on a worker thread.
+     * @param data Index of the worker.
+     * @return Never returns.
+     */
+    static int32_t work(void* data);
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Blocks the worker until every worker reaches the barrier.
+     */
+    static void barrier();
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Blocks until the workers finish preparing the current frame.
+     */
+    static void wait();
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Copies the screen areas of a prepared frame back to the live
+     * render proxies still owned by the same renderable instances.
+     * @param frame Prepared frame.
+     */
+    static void publish(frame const& frame);
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Counts an issued SDL call.
+     * @param result Result of the SDL call.
+     * @return Whether the SDL call failed or not.
+     */
+    [[nodiscard]] static bool failed(int32_t result);
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Applies color modifiers to a texture unless they are already
+     * applied.
+     * @param texture Modulated texture.
+     * @param color_r Red color modifier of the texture.
+     * @param color_g Green color modifier of the texture.
+     * @param color_b Blue color modifier of the texture.
+     * @param color_a Alpha color modifier of the texture.
+     * @return Whether modulating the texture failed or not.
+     * @note Only textures held by the renderer are modulated, they are
+     * forgotten when they are replaced.
+     */
+    [[nodiscard]] static bool modulate(texture* texture, uint8_t color_r,
+                                       uint8_t color_g, uint8_t color_b,
+                                       uint8_t color_a);
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Returns the time elapsed since a performance counter value.
+     * @param start Performance counter value.
+     * @return Elapsed time in milliseconds.
+     */
+    [[nodiscard]] static float elapsed(uint64_t start);
+
     /**
      * @file renderer.hpp
      * @author Zana Domán
@@ -69,13 +568,38 @@ class renderer final {
      */
     static void open_frame();
 
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Returns whether color modifiers leave a layer unchanged or not.
+     * @param color_r Red color modifier of the layer.
+     * @param color_g Green color modifier of the layer.
+     * @param color_b Blue color modifier of the layer.
+     * @param color_a Alpha color modifier of the layer.
+     * @return Whether the color modifiers leave the layer unchanged or not.
+     */
+    [[nodiscard]] static bool identity(uint8_t color_r, uint8_t color_g,
+                                       uint8_t color_b, uint8_t color_a);
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Collects the statistics of the layers of a prepared frame and
+     * chooses their render passes, empty layers are skipped and a single layer
+     * with identity color modifiers is rendered directly onto the frame.
+     * @param frame Prepared frame.
+     * @note A retained plane keeps its render pass until it is rendered again.
+     */
+    static void plan(frame const& frame);
+
     /**
      * @file renderer.hpp
      * @author Zana Domán
      * @brief Opens the space to render on.
+     * @param frame Prepared frame.
      * @warning If the space cannot be opened, throws wze::exception.
      */
-    static void open_space();
+    static void open_space(frame const& frame);
 
     /**
      * @file renderer.hpp
@@ -87,49 +611,60 @@ class renderer final {
 
     /**
      * @file renderer.hpp
-     * @author Zana Domán, Gunics Roland
-     * @brief Returns the visibility of a renderable instance.
-     * @param instance Renderable instance.
-     * @return Visibility of the renderable instance.
+     * @author Zana Domán
+     * @brief Renders a batch list onto the new frame.
+     * @param slice Slice holding the vertices.
+     * @param batches Batch list of the layer.
+     * @param bound Texture of the previous batch of the layer.
+     * @warning If a batch cannot be rendered, throws wze::exception.
      */
-    [[nodiscard]] static bool invisible(renderable const& instance);
+    static void flush(slice const& slice, std::vector<batch> const& batches,
+                      wze::texture*& bound);
 
     /**
      * @file renderer.hpp
-     * @author Zana Domán, Gunics Roland
-     * @brief Transforms a renderable instance.
-     * @param instance Renderable instance.
+     * @author Zana Domán
+     * @brief Reads the new frame back into the screenshot.
+     * @note The screenshot is reallocated if it is shared or the output size
+     * changed, so screenshots of previous frames stay intact.
+     * @warning If the new frame cannot be read back, throws wze::exception.
      */
-    static void transform(renderable& instance);
+    static void read();
 
     /**
      * @file renderer.hpp
      * @author Zana Domán
-     * @brief Returns whether a renderable instance is inside the bounds of
-     * the screen or not.
-     * @param instance Renderable instance.
-     * @return Whether the renderable instance is inside the bounds of the
-     * screen or not.
+     * @brief Composes and reads back the new frame.
+     * @warning If the new frame cannot be composed, throws wze::exception.
      */
-    [[nodiscard]] static bool offscreen(renderable const& instance);
+    static void close_frame();
 
     /**
      * @file renderer.hpp
      * @author Zana Domán
-     * @brief Renders a renderable instance onto the new frame.
-     * @param instance Renderable instance.
-     * @warning If the renderable instance cannot be rendered, throws
-     * wze::exception.
+     * @brief Submits a prepared frame.
+     * @param frame Prepared frame.
+     * @warning If the frame cannot be submitted, throws wze::exception.
      */
-    static void render(renderable const& instance);
+    static void submit(frame const& frame);
 
     /**
      * @file renderer.hpp
      * @author Zana Domán
-     * @brief Presents the new frame.
-     * @warning If the new frame cannot be presented, throws wze::exception.
+     * @brief Creates the render target of the space at the resolution scale.
+     * @warning If the render target cannot be created, throws wze::exception.
      */
-    static void close_frame();
+    static void resize_space();
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Adjusts the resolution scale of the space to the resolution
+     * budget.
+     * @param submit_time Time of the last submission in milliseconds.
+     * @warning If the render target cannot be created, throws wze::exception.
+     */
+    static void adapt(float submit_time);
 
   public:
     /**
@@ -390,15 +925,183 @@ class renderer final {
      */
     static void set_plane_color_a(uint8_t plane_color_a);
 
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Returns whether the plane is retained between frames or not.
+     * @return Whether the plane is retained between frames or not.
+     */
+    [[nodiscard]] static bool plane_retained();
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Sets whether the plane is retained between frames or not.
+     * @param plane_retained Whether the plane is retained between frames or
+     * not.
+     * @note A retained plane is only rendered again when a plane renderable is
+     * added, removed or changed, otherwise the previous frame is reused.
+     */
+    static void set_plane_retained(bool plane_retained);
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Returns the resolution scale of the space.
+     * @return Resolution scale of the space.
+     */
+    [[nodiscard]] static float resolution_scale();
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Sets the resolution scale of the space.
+     * @param resolution_scale Resolution scale of the space.
+     * @note The space is rendered into a render target of the scaled size and
+     * upscaled onto the frame, the plane stays at full resolution. The scale
+     * is rounded to steps of 0.05 between 0.5 and 1.
+     * @warning If the render target cannot be created, throws wze::exception.
+     */
+    static void set_resolution_scale(float resolution_scale);
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Returns the resolution budget of the frames in milliseconds.
+     * @return Resolution budget of the frames in milliseconds.
+     */
+    [[nodiscard]] static float resolution_budget();
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Sets the resolution budget of the frames in milliseconds.
+     * @param resolution_budget Resolution budget of the frames in
+     * milliseconds, 0 to keep the resolution scale fixed.
+     * @note The resolution scale of the space is lowered while the smoothed
+     * submission time exceeds the budget and raised while it stays below
+     * 80% of it. The submission time excludes presenting the frame, so
+     * waiting for vertical synchronization does not lower the scale.
+     */
+    static void set_resolution_budget(float resolution_budget);
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Forces the retained plane to be rendered again in the next frame.
+     * @note Changes of the texture contents are not tracked, this method must
+     * be called after rendering into a texture used on the plane.
+     */
+    static void invalidate_plane();
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Returns the number of frames that reused the retained plane.
+     * @return Number of frames that reused the retained plane.
+     */
+    [[nodiscard]] static size_t plane_reuses();
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Returns the number of frames that rendered the plane.
+     * @return Number of frames that rendered the plane.
+     */
+    [[nodiscard]] static size_t plane_redraws();
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Returns whether the frames are prepared on worker threads or
+     * not.
+     * @return Whether the frames are prepared on worker threads or not.
+     */
+    [[nodiscard]] static bool pipelined();
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Sets whether the frames are prepared on worker threads or not.
+     * @param pipelined Whether the frames are prepared on worker threads or
+     * not.
+     * @note A pipelined frame is prepared while the game logic of the next one
+     * runs and it is submitted by the next update, so the screen areas of the
+     * renderable instances and the presented frame lag one update behind.
+     * Textures not created by wze::assets must outlive the update after their
+     * last use. Stays serial if threads are not supported.
+     * @warning If the workers cannot be synchronized, throws wze::exception.
+     */
+    static void set_pipelined(bool pipelined);
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Returns the statistics of the last frame.
+     * @return Statistics of the last frame.
+     * @note The statistics are always collected. When pipelined, the layer
+     * statistics describe the submitted frame, which lags one update behind.
+     */
+    [[nodiscard]] static render_stats const& stats();
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Returns whether the frames are read back or not.
+     * @return Whether the frames are read back or not.
+     */
+    [[nodiscard]] static bool readback();
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Sets whether the frames are read back or not.
+     * @param readback Whether the frames are read back or not.
+     * @note Reading back stalls the renderer until the frame is finished, it
+     * is meant for tests and benchmarks.
+     */
+    static void set_readback(bool readback);
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Returns the last frame read back.
+     * @return Last frame read back, null if the frames are not read back.
+     * @note The pixels are stored in the RGBA byte order.
+     */
+    [[nodiscard]] static std::shared_ptr<image> const& screenshot();
+
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Returns the hash of the last frame read back.
+     * @return Hash of the last frame read back.
+     * @note With the software renderer and a fixed delta time the hashes are
+     * reproducible between runs and platforms.
+     * @sa assets::digest_image
+     */
+    [[nodiscard]] static uint64_t frame_hash();
+
+#ifdef __WIZARD_ENGINE_INTERNAL__
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Destroys a texture once no pending frame can refer to it.
+     * @param texture Destroyed texture.
+     */
+    static void release(texture* texture);
+#endif /* __WIZARD_ENGINE_INTERNAL__ */
+
 #ifdef __WIZARD_ENGINE_INTERNAL__
     /**
      * @file renderer.hpp
      * @author Zana Domán
      * @brief Initializes the renderer subsystem.
+     * @param software Whether the software renderer is used or not.
      * @warning If the renderer subsystem cannot be initialized, throws
      * wze::exception.
      */
-    static void initialize();
+    static void initialize(bool software);
 #endif /* __WIZARD_ENGINE_INTERNAL__ */
 
 #ifdef __WIZARD_ENGINE_INTERNAL__
@@ -410,6 +1113,29 @@ class renderer final {
     static void update();
 #endif /* __WIZARD_ENGINE_INTERNAL__ */
 
+#ifdef __WIZARD_ENGINE_INTERNAL__
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Remembers the positions of the render proxies before a
+     * simulation tick.
+     */
+    static void remember();
+#endif /* __WIZARD_ENGINE_INTERNAL__ */
+
+#ifdef __WIZARD_ENGINE_INTERNAL__
+    /**
+     * @file renderer.hpp
+     * @author Zana Domán
+     * @brief Sets how far the frames are between the previous and the current
+     * simulation tick.
+     * @param interpolation Fraction of a tick, 1 to render the current tick.
+     * @note The spatial grid culls by the current tick, so it may lag one
+     * tick of movement behind the interpolated positions.
+     */
+    static void interpolate(float interpolation);
+#endif /* __WIZARD_ENGINE_INTERNAL__ */
+
 #ifdef __WIZARD_ENGINE_INTERNAL__
     /**
      * @file renderer.hpp
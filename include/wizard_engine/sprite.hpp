@@ -28,30 +28,18 @@
 #include <wizard_engine/enums.hpp>
 #include <wizard_engine/export.hpp>
 #include <wizard_engine/renderable.hpp>
+#include <wizard_engine/texture_atlas.hpp>
 
 namespace wze {
 /**
  * @file sprite.hpp
  * @author Zana Domán
  * @brief Renderable animatable component.
+ * @note The render state of the sprite is stored in its render proxy.
  */
 class sprite final : public renderable, public animatable, public component {
   private:
-    float _x;
-    float _y;
-    float _z;
-    float _angle;
-    float _width;
-    float _height;
-    bool _spatial;
-    std::shared_ptr<wze::texture> _texture;
-    uint8_t _color_r;
-    uint8_t _color_g;
-    uint8_t _color_b;
-    uint8_t _color_a;
-    enum flip _flip;
-    bool _visible;
-    uint8_t _priority;
+    texture_region _region;
     bool _animated;
     float _x_offset;
     float _y_offset;
@@ -193,6 +181,24 @@ class sprite final : public renderable, public animatable, public component {
      */
     void set_texture(std::shared_ptr<wze::texture> const& texture) final;
 
+    /**
+     * @file sprite.hpp
+     * @author Zana Domán
+     * @brief Returns the drawn region of the texture of the sprite.
+     * @return Drawn region of the texture of the sprite.
+     */
+    [[nodiscard]] texture_region const& region() const;
+
+    /**
+     * @file sprite.hpp
+     * @author Zana Domán
+     * @brief Sets the drawn region of the texture of the sprite.
+     * @param region Drawn region of the texture of the sprite.
+     * @note Sprites drawn from the same texture atlas page are batched
+     * together.
+     */
+    void set_region(texture_region const& region) final;
+
     /**
      * @file sprite.hpp
      * @author Zana Domán
@@ -0,0 +1,164 @@
+/*
+  Wizard Engine
+  Copyright (C) 2023-2024 Zana Domán
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef WIZARD_ENGINE_TEXTURE_ATLAS_HPP
+#define WIZARD_ENGINE_TEXTURE_ATLAS_HPP
+
+#include <wizard_engine/assets.hpp>
+#include <wizard_engine/export.hpp>
+
+namespace wze {
+/**
+ * @file texture_atlas.hpp
+ * @author Zana Domán
+ * @brief Region of a texture.
+ * @note The source of the region is given in texture coordinates ranging
+ * from 0 to 1, the whole texture is {0, 0, 1, 1}.
+ */
+struct texture_region {
+    std::shared_ptr<wze::texture> texture;
+    SDL_FRect source;
+};
+
+/**
+ * @file texture_atlas.hpp
+ * @author Zana Domán
+ * @brief Packs images into the pages of shared textures.
+ * @note Each page is packed with a bottom left skyline. Objects drawn from
+ * the same page are batched together by the renderer.
+ */
+class texture_atlas final {
+  private:
+    /**
+     * @file texture_atlas.hpp
+     * @author Zana Domán
+     * @brief Horizontal segment of the skyline of a page.
+     */
+    struct segment {
+        int32_t x;
+        int32_t y;
+        int32_t width;
+    };
+
+    static constexpr uint16_t _default_size = 2048;
+    static constexpr uint8_t _padding = 1;
+    uint16_t _size;
+    std::vector<std::shared_ptr<wze::texture>> _pages;
+    std::vector<std::vector<segment>> _skylines;
+    size_t _regions;
+
+    /**
+     * @file texture_atlas.hpp
+     * @author Zana Domán
+     * @brief Finds the lowest position of an area on a skyline.
+     * @param skyline Skyline of the page.
+     * @param width Width of the area.
+     * @param height Height of the area.
+     * @param position Lowest position of the area.
+     * @return Index of the first segment under the area, the size of the
+     * skyline if the area does not fit.
+     */
+    [[nodiscard]] size_t fit(std::vector<segment> const& skyline, int32_t width,
+                             int32_t height, SDL_Point& position) const;
+
+    /**
+     * @file texture_atlas.hpp
+     * @author Zana Domán
+     * @brief Raises a skyline under a placed area.
+     * @param skyline Skyline of the page.
+     * @param index Index of the first segment under the area.
+     * @param area Placed area.
+     */
+    static void raise(std::vector<segment>& skyline, size_t index,
+                      SDL_Rect const& area);
+
+    /**
+     * @file texture_atlas.hpp
+     * @author Zana Domán
+     * @brief Creates a new page cleared to transparent black.
+     * @warning If the texture cannot be created, throws wze::exception.
+     */
+    void grow();
+
+  public:
+    /**
+     * @file texture_atlas.hpp
+     * @author Zana Domán
+     * @brief Returns the width and height of the pages.
+     * @return Width and height of the pages.
+     */
+    [[nodiscard]] uint16_t size() const;
+
+    /**
+     * @file texture_atlas.hpp
+     * @author Zana Domán
+     * @brief Returns the pages of the texture atlas.
+     * @return Pages of the texture atlas.
+     */
+    [[nodiscard]] std::vector<std::shared_ptr<wze::texture>> const&
+    pages() const;
+
+    /**
+     * @file texture_atlas.hpp
+     * @author Zana Domán
+     * @brief Returns the number of regions packed into the texture atlas.
+     * @return Number of regions packed into the texture atlas.
+     */
+    [[nodiscard]] size_t regions() const;
+
+    /**
+     * @file texture_atlas.hpp
+     * @author Zana Domán
+     * @brief Packs an image into the texture atlas.
+     * @param image Packed image.
+     * @return Region of the image.
+     * @note A new page is created if the image does not fit into the existing
+     * ones.
+     * @warning If the image is null, larger than a page or cannot be
+     * uploaded, throws wze::exception.
+     */
+    [[nodiscard]] texture_region insert(std::shared_ptr<image> const& image);
+
+    /**
+     * @file texture_atlas.hpp
+     * @author Zana Domán
+     * @brief Packs images into the texture atlas.
+     * @param images Packed images.
+     * @return Regions of the images in the order of the images.
+     * @note The images are packed from the tallest to the shortest, which
+     * wastes less space than packing them one by one.
+     * @warning If an image is null, larger than a page or cannot be
+     * uploaded, throws wze::exception.
+     */
+    [[nodiscard]] std::vector<texture_region>
+    insert(std::vector<std::shared_ptr<image>> const& images);
+
+    /**
+     * @file texture_atlas.hpp
+     * @author Zana Domán
+     * @brief Constructs a texture atlas instance.
+     * @param size Width and height of the pages.
+     */
+    explicit texture_atlas(uint16_t size = _default_size);
+};
+} /* namespace wze */
+
+#endif /* WIZARD_ENGINE_TEXTURE_ATLAS_HPP */
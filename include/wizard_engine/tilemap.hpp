@@ -0,0 +1,348 @@
+/*
+  Wizard Engine
+  Copyright (C) 2023-2024 Zana Domán
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef WIZARD_ENGINE_TILEMAP_HPP
+#define WIZARD_ENGINE_TILEMAP_HPP
+
+#include <wizard_engine/assets.hpp>
+#include <wizard_engine/export.hpp>
+#include <wizard_engine/sprite.hpp>
+
+namespace wze {
+/**
+ * @file tilemap.hpp
+ * @author Zana Domán
+ * @brief Grid of tiles from an atlas, baked into chunk textures.
+ * @note Each chunk is drawn as a single sprite, so only the chunks
+ * intersecting the screen are drawn. The chunks are baked again when the
+ * render targets are lost.
+ */
+class tilemap final {
+  private:
+    static constexpr uint16_t _default_chunk_size = 32;
+    static std::vector<tilemap*> _instances;
+    float _x;
+    float _y;
+    float _z;
+    float _tile_width;
+    float _tile_height;
+    bool _spatial;
+    std::shared_ptr<wze::texture> _atlas;
+    uint16_t _cell_width;
+    uint16_t _cell_height;
+    size_t _columns;
+    size_t _rows;
+    uint16_t _chunk_size;
+    bool _visible;
+    uint8_t _priority;
+    std::vector<uint16_t> _tiles;
+    std::vector<sprite> _chunks;
+    std::vector<uint8_t> _dirty;
+
+    /**
+     * @file tilemap.hpp
+     * @author Zana Domán
+     * @brief Returns the number of chunk columns of the tilemap.
+     * @return Number of chunk columns of the tilemap.
+     */
+    [[nodiscard]] size_t chunk_columns() const;
+
+    /**
+     * @file tilemap.hpp
+     * @author Zana Domán
+     * @brief Returns the number of chunk rows of the tilemap.
+     * @return Number of chunk rows of the tilemap.
+     */
+    [[nodiscard]] size_t chunk_rows() const;
+
+    /**
+     * @file tilemap.hpp
+     * @author Zana Domán
+     * @brief Moves the chunks to the position of the tilemap.
+     */
+    void arrange();
+
+    /**
+     * @file tilemap.hpp
+     * @author Zana Domán
+     * @brief Bakes the tiles of a chunk into its texture.
+     * @param chunk Index of the chunk.
+     * @warning If the texture cannot be baked, throws wze::exception.
+     */
+    void bake(size_t chunk);
+
+  public:
+    /**
+     * @file tilemap.hpp
+     * @author Zana Domán
+     * @brief Returns the x position of the tilemap.
+     * @return X position of the tilemap.
+     */
+    [[nodiscard]] float x() const;
+
+    /**
+     * @file tilemap.hpp
+     * @author Zana Domán
+     * @brief Sets the x position of the tilemap.
+     * @param x X position of the tilemap.
+     */
+    void set_x(float x);
+
+    /**
+     * @file tilemap.hpp
+     * @author Zana Domán
+     * @brief Returns the y position of the tilemap.
+     * @return Y position of the tilemap.
+     */
+    [[nodiscard]] float y() const;
+
+    /**
+     * @file tilemap.hpp
+     * @author Zana Domán
+     * @brief Sets the y position of the tilemap.
+     * @param y Y position of the tilemap.
+     */
+    void set_y(float y);
+
+    /**
+     * @file tilemap.hpp
+     * @author Zana Domán
+     * @brief Returns the z position of the tilemap.
+     * @return Z position of the tilemap.
+     */
+    [[nodiscard]] float z() const;
+
+    /**
+     * @file tilemap.hpp
+     * @author Zana Domán
+     * @brief Sets the z position of the tilemap.
+     * @param z Z position of the tilemap.
+     */
+    void set_z(float z);
+
+    /**
+     * @file tilemap.hpp
+     * @author Zana Domán
+     * @brief Returns the width of the tiles of the tilemap.
+     * @return Width of the tiles of the tilemap.
+     */
+    [[nodiscard]] float tile_width() const;
+
+    /**
+     * @file tilemap.hpp
+     * @author Zana Domán
+     * @brief Returns the height of the tiles of the tilemap.
+     * @return Height of the tiles of the tilemap.
+     */
+    [[nodiscard]] float tile_height() const;
+
+    /**
+     * @file tilemap.hpp
+     * @author Zana Domán
+     * @brief Returns the spatiality of the tilemap.
+     * @return Spatiality of the tilemap.
+     */
+    [[nodiscard]] bool spatial() const;
+
+    /**
+     * @file tilemap.hpp
+     * @author Zana Domán
+     * @brief Sets the spatiality of the tilemap.
+     * @param spatial Spatiality of the tilemap.
+     */
+    void set_spatial(bool spatial);
+
+    /**
+     * @file tilemap.hpp
+     * @author Zana Domán
+     * @brief Returns the atlas of the tilemap.
+     * @return Atlas of the tilemap.
+     */
+    [[nodiscard]] std::shared_ptr<wze::texture> const& atlas() const;
+
+    /**
+     * @file tilemap.hpp
+     * @author Zana Domán
+     * @brief Returns the width of the atlas cells of the tilemap.
+     * @return Width of the atlas cells of the tilemap.
+     */
+    [[nodiscard]] uint16_t cell_width() const;
+
+    /**
+     * @file tilemap.hpp
+     * @author Zana Domán
+     * @brief Returns the height of the atlas cells of the tilemap.
+     * @return Height of the atlas cells of the tilemap.
+     */
+    [[nodiscard]] uint16_t cell_height() const;
+
+    /**
+     * @file tilemap.hpp
+     * @author Zana Domán
+     * @brief Returns the number of tile columns of the tilemap.
+     * @return Number of tile columns of the tilemap.
+     */
+    [[nodiscard]] size_t columns() const;
+
+    /**
+     * @file tilemap.hpp
+     * @author Zana Domán
+     * @brief Returns the number of tile rows of the tilemap.
+     * @return Number of tile rows of the tilemap.
+     */
+    [[nodiscard]] size_t rows() const;
+
+    /**
+     * @file tilemap.hpp
+     * @author Zana Domán
+     * @brief Returns the chunk size of the tilemap.
+     * @return Chunk size of the tilemap.
+     * @note The chunks are square areas of chunk size by chunk size tiles.
+     */
+    [[nodiscard]] uint16_t chunk_size() const;
+
+    /**
+     * @file tilemap.hpp
+     * @author Zana Domán
+     * @brief Returns the visibility of the tilemap.
+     * @return Visibility of the tilemap.
+     */
+    [[nodiscard]] bool visible() const;
+
+    /**
+     * @file tilemap.hpp
+     * @author Zana Domán
+     * @brief Sets the visibility of the tilemap.
+     * @param visible Visibility of the tilemap.
+     */
+    void set_visible(bool visible);
+
+    /**
+     * @file tilemap.hpp
+     * @author Zana Domán
+     * @brief Returns the priority of the tilemap.
+     * @return Priority of the tilemap.
+     */
+    [[nodiscard]] uint8_t priority() const;
+
+    /**
+     * @file tilemap.hpp
+     * @author Zana Domán
+     * @brief Sets the priority of the tilemap.
+     * @param priority Priority of the tilemap.
+     */
+    void set_priority(uint8_t priority);
+
+    /**
+     * @file tilemap.hpp
+     * @author Zana Domán
+     * @brief Returns a tile of the tilemap.
+     * @param column Column of the tile.
+     * @param row Row of the tile.
+     * @return Atlas cell of the tile counted from 1, 0 if the tile is empty.
+     */
+    [[nodiscard]] uint16_t tile(size_t column, size_t row) const;
+
+    /**
+     * @file tilemap.hpp
+     * @author Zana Domán
+     * @brief Sets a tile of the tilemap.
+     * @param column Column of the tile.
+     * @param row Row of the tile.
+     * @param tile Atlas cell of the tile counted from 1, 0 if the tile is
+     * empty.
+     * @note The chunk of the tile is baked again by the next bake.
+     */
+    void set_tile(size_t column, size_t row, uint16_t tile);
+
+    /**
+     * @file tilemap.hpp
+     * @author Zana Domán
+     * @brief Bakes the chunks changed since the last bake.
+     * @warning If a texture cannot be baked, throws wze::exception.
+     */
+    void bake();
+
+#ifdef __WIZARD_ENGINE_INTERNAL__
+    /**
+     * @file tilemap.hpp
+     * @author Zana Domán
+     * @brief Bakes every chunk of every tilemap again after the render
+     * targets are lost.
+     * @warning If a texture cannot be baked, throws wze::exception.
+     */
+    static void reset();
+#endif /* __WIZARD_ENGINE_INTERNAL__ */
+
+    /**
+     * @file tilemap.hpp
+     * @author Zana Domán
+     * @param x X position of the top left corner of the tilemap.
+     * @param y Y position of the top left corner of the tilemap.
+     * @param z Z position of the tilemap.
+     * @param tile_width Width of the tiles.
+     * @param tile_height Height of the tiles.
+     * @param spatial Spatiality of the tilemap.
+     * @param atlas Atlas of the tiles.
+     * @param cell_width Width of the atlas cells in pixels.
+     * @param cell_height Height of the atlas cells in pixels.
+     * @param columns Number of tile columns.
+     * @param rows Number of tile rows.
+     * @param tiles Tiles of the tilemap row by row, empty if unspecified.
+     * @param chunk_size Chunk size of the tilemap.
+     * @param visible Visibility of the tilemap.
+     * @param priority Priority of the tilemap.
+     * @warning If a texture cannot be baked, throws wze::exception.
+     */
+    tilemap(float x, float y, float z, float tile_width, float tile_height,
+            bool spatial, std::shared_ptr<wze::texture> const& atlas,
+            uint16_t cell_width, uint16_t cell_height, size_t columns,
+            size_t rows, std::vector<uint16_t> const& tiles = {},
+            uint16_t chunk_size = _default_chunk_size, bool visible = true,
+            uint8_t priority = std::numeric_limits<uint8_t>::max() / 2);
+
+    /**
+     * @file tilemap.hpp
+     * @author Zana Domán
+     * @brief Copy constructor.
+     * @param other Other tilemap instance.
+     */
+    tilemap(tilemap const& other);
+
+    /**
+     * @file tilemap.hpp
+     * @author Zana Domán
+     * @brief Destroys the tilemap instance.
+     */
+    ~tilemap();
+
+    /**
+     * @file tilemap.hpp
+     * @author Zana Domán
+     * @brief Copy assignment operator.
+     * @param other Other tilemap instance.
+     * @return Self reference.
+     */
+    tilemap& operator=(tilemap const& other) = default;
+};
+} /* namespace wze */
+
+#endif /* WIZARD_ENGINE_TILEMAP_HPP */
@@ -31,6 +31,21 @@
 #include <wizard_engine/export.hpp>
 
 namespace wze {
+/**
+ * @brief Statistics of the frame pacing.
+ * @details The pacing error is the difference between the end of a frame and
+ * its deadline in milliseconds, negative if the frame ends early. A frame is
+ * missed if it ends after the deadline without waiting.
+ * @sa timer::stats()
+ */
+struct pacing_stats {
+    size_t frames;
+    size_t missed;
+    float error;
+    float mean_error;
+    float max_error;
+};
+
 /**
  * @brief Timer modul.
  */
@@ -44,16 +59,37 @@ class timer final {
     /**
      * @brief Gets the target frame time in milliseconds.
      * @return Target frame time in milliseconds.
-     * @sa set_frame_time(uint8_t frame_time)
+     * @sa set_frame_time(float frame_time)
      */
-    [[nodiscard]] static uint8_t frame_time();
+    [[nodiscard]] static float frame_time();
 
     /**
      * @brief Sets the target frame time in milliseconds.
      * @param frame_time Target frame time in milliseconds.
+     * @details Without precise pacing the target frame time is waited in
+     * whole milliseconds.
      * @sa frame_time()
+     * @sa set_precise(bool precise)
      */
-    static void set_frame_time(uint8_t frame_time);
+    static void set_frame_time(float frame_time);
+
+    /**
+     * @brief Gets whether the frames are paced precisely or not.
+     * @return Whether the frames are paced precisely or not.
+     * @sa set_precise(bool precise)
+     */
+    [[nodiscard]] static bool precise();
+
+    /**
+     * @brief Sets whether the frames are paced precisely or not.
+     * @param precise Whether the frames are paced precisely or not.
+     * @details Precise pacing sleeps until shortly before the deadline of the
+     * frame and spins for the rest, on the performance counter. The deadlines
+     * follow each other by exactly the target frame time, so fractional
+     * frame times do not drift.
+     * @sa precise()
+     */
+    static void set_precise(bool precise);
 
     /**
      * @brief Gets the current delta time in milliseconds.
@@ -69,12 +105,43 @@ class timer final {
      */
     static void set_delta_time(float delta_time);
 
+    /**
+     * @brief Gets the fixed delta time in milliseconds.
+     * @return Fixed delta time in milliseconds, 0 if the delta time is
+     * measured.
+     * @sa set_fixed_delta_time(float fixed_delta_time)
+     */
+    [[nodiscard]] static float fixed_delta_time();
+
+    /**
+     * @brief Sets the fixed delta time in milliseconds.
+     * @param fixed_delta_time Fixed delta time in milliseconds, 0 to measure
+     * the delta time.
+     * @details A fixed delta time makes the updates independent of the wall
+     * clock, the frames are neither measured nor limited.
+     * @sa fixed_delta_time()
+     */
+    static void set_fixed_delta_time(float fixed_delta_time);
+
     /**
      * @brief Gets the current game time in milliseconds.
      * @return Current game time in milliseconds.
      */
     [[nodiscard]] static uint32_t current_time();
 
+    /**
+     * @brief Gets the statistics of the frame pacing.
+     * @return Statistics of the frame pacing since the last reset.
+     * @sa reset_stats()
+     */
+    [[nodiscard]] static pacing_stats const& stats();
+
+    /**
+     * @brief Resets the statistics of the frame pacing.
+     * @sa stats()
+     */
+    static void reset_stats();
+
 #ifdef __WIZARD_ENGINE_INTERNAL__
     /**
      * @brief Updates the timer subsystem.
@@ -83,9 +150,42 @@ class timer final {
 #endif /* __WIZARD_ENGINE_INTERNAL__ */
 
   private:
-    static uint8_t _frame_time;
+    static float _frame_time;
+    static bool _precise;
     static float _delta_time;
-    static uint32_t _last_time;
+    static float _fixed_delta_time;
+    static uint64_t _last_time;
+    static uint64_t _deadline;
+    static pacing_stats _stats;
+
+    /**
+     * @brief Converts milliseconds to performance counter ticks.
+     * @param milliseconds Milliseconds.
+     * @return Performance counter ticks.
+     */
+    [[nodiscard]] static uint64_t ticks(float milliseconds);
+
+    /**
+     * @brief Converts performance counter ticks to milliseconds.
+     * @param ticks Performance counter ticks.
+     * @return Milliseconds.
+     */
+    [[nodiscard]] static float milliseconds(uint64_t ticks);
+
+    /**
+     * @brief Waits until a deadline by sleeping, then spinning.
+     * @param deadline Deadline in performance counter ticks.
+     * @return Performance counter after the wait.
+     */
+    [[nodiscard]] static uint64_t wait(uint64_t deadline);
+
+    /**
+     * @brief Records the pacing error of a frame.
+     * @param now Performance counter at the end of the frame.
+     * @param deadline Deadline of the frame in performance counter ticks.
+     * @param missed Whether the deadline was missed or not.
+     */
+    static void record(uint64_t now, uint64_t deadline, bool missed);
 };
 } /* namespace wze */
 
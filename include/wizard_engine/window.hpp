@@ -119,11 +119,13 @@ class window final {
      * @param title Title of the game window.
      * @param width Width of the game window.
      * @param height Height of the game window.
+     * @param hidden Whether the game window is hidden or not.
+     * @note A hidden game window is not fullscreen and has no icon.
      * @warning If the window subystem cannot be initialized, throws
      * wze::exception.
      */
     static void initialize(std::string const& title, uint16_t width,
-                           uint16_t height);
+                           uint16_t height, bool hidden);
 #endif /* __WIZARD_ENGINE_INTERNAL__ */
 };
 } /* namespace wze */
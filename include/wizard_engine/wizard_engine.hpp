@@ -39,31 +39,37 @@
 #error Illegal external access to internal assembly
 #endif /* __WIZARD_ENGINE_INTERNAL__ */
 
-#include <wizard_engine/animatable.hpp> /* IWYU pragma: export */
-#include <wizard_engine/animator.hpp>   /* IWYU pragma: export */
-#include <wizard_engine/assets.hpp>     /* IWYU pragma: export */
-#include <wizard_engine/audio.hpp>      /* IWYU pragma: export */
-#include <wizard_engine/camera.hpp>     /* IWYU pragma: export */
-#include <wizard_engine/collider.hpp>   /* IWYU pragma: export */
-#include <wizard_engine/component.hpp>  /* IWYU pragma: export */
-#include <wizard_engine/engine.hpp>     /* IWYU pragma: export */
-#include <wizard_engine/entity.hpp>     /* IWYU pragma: export */
-#include <wizard_engine/enums.hpp>      /* IWYU pragma: export */
-#include <wizard_engine/exception.hpp>  /* IWYU pragma: export */
-#include <wizard_engine/export.hpp>     /* IWYU pragma: export */
-#include <wizard_engine/input.hpp>      /* IWYU pragma: export */
-#include <wizard_engine/math.hpp>       /* IWYU pragma: export */
-#include <wizard_engine/net.hpp>        /* IWYU pragma: export */
-#include <wizard_engine/polygon.hpp>    /* IWYU pragma: export */
-#include <wizard_engine/renderable.hpp> /* IWYU pragma: export */
-#include <wizard_engine/renderer.hpp>   /* IWYU pragma: export */
-#include <wizard_engine/socket.hpp>     /* IWYU pragma: export */
-#include <wizard_engine/speaker.hpp>    /* IWYU pragma: export */
-#include <wizard_engine/sprite.hpp>     /* IWYU pragma: export */
-#include <wizard_engine/tcp_socket.hpp> /* IWYU pragma: export */
-#include <wizard_engine/timer.hpp>      /* IWYU pragma: export */
-#include <wizard_engine/udp_socket.hpp> /* IWYU pragma: export */
-#include <wizard_engine/window.hpp>     /* IWYU pragma: export */
+#include <wizard_engine/animatable.hpp>       /* IWYU pragma: export */
+#include <wizard_engine/animator.hpp>         /* IWYU pragma: export */
+#include <wizard_engine/assets.hpp>           /* IWYU pragma: export */
+#include <wizard_engine/audio.hpp>            /* IWYU pragma: export */
+#include <wizard_engine/camera.hpp>           /* IWYU pragma: export */
+#include <wizard_engine/collider.hpp>         /* IWYU pragma: export */
+#include <wizard_engine/component.hpp>        /* IWYU pragma: export */
+#include <wizard_engine/engine.hpp>           /* IWYU pragma: export */
+#include <wizard_engine/entity.hpp>           /* IWYU pragma: export */
+#include <wizard_engine/enums.hpp>            /* IWYU pragma: export */
+#include <wizard_engine/exception.hpp>        /* IWYU pragma: export */
+#include <wizard_engine/export.hpp>           /* IWYU pragma: export */
+#include <wizard_engine/glyph_atlas.hpp>      /* IWYU pragma: export */
+#include <wizard_engine/input.hpp>            /* IWYU pragma: export */
+#include <wizard_engine/label.hpp>            /* IWYU pragma: export */
+#include <wizard_engine/math.hpp>             /* IWYU pragma: export */
+#include <wizard_engine/net.hpp>              /* IWYU pragma: export */
+#include <wizard_engine/pack.hpp>             /* IWYU pragma: export */
+#include <wizard_engine/particle_emitter.hpp> /* IWYU pragma: export */
+#include <wizard_engine/polygon.hpp>          /* IWYU pragma: export */
+#include <wizard_engine/renderable.hpp>       /* IWYU pragma: export */
+#include <wizard_engine/renderer.hpp>         /* IWYU pragma: export */
+#include <wizard_engine/socket.hpp>           /* IWYU pragma: export */
+#include <wizard_engine/speaker.hpp>          /* IWYU pragma: export */
+#include <wizard_engine/sprite.hpp>           /* IWYU pragma: export */
+#include <wizard_engine/tcp_socket.hpp>       /* IWYU pragma: export */
+#include <wizard_engine/texture_atlas.hpp>    /* IWYU pragma: export */
+#include <wizard_engine/tilemap.hpp>          /* IWYU pragma: export */
+#include <wizard_engine/timer.hpp>            /* IWYU pragma: export */
+#include <wizard_engine/udp_socket.hpp>       /* IWYU pragma: export */
+#include <wizard_engine/window.hpp>           /* IWYU pragma: export */
 
 /**
  * @def wze_main
@@ -25,87 +25,235 @@
 #include <wizard_engine/animator.hpp>
 #include <wizard_engine/timer.hpp>
 
-wze::animator::animator(
-    std::vector<std::pair<std::shared_ptr<texture>, uint16_t>> const& frames,
-    std::vector<std::weak_ptr<animatable>> const& targets) {
-    this->frames() = frames;
-    this->targets() = targets;
-    set_current_frame(0);
-    _remaining_time = 0;
+wze::animation_tracks wze::animator::_tracks = {};
+std::unordered_map<wze::animatable const*, size_t> wze::animator::_indices =
+    {};
+std::vector<wze::animator*> wze::animator::_instances = {};
+
+wze::animatable::animatable(animatable const& other) {
+    animator::copy(other, *this);
 }
 
-std::vector<std::pair<std::shared_ptr<wze::texture>, uint16_t>> const&
-wze::animator::frames() const {
-    return _frames;
+wze::animatable::~animatable() {
+    animator::release(this);
 }
 
-std::vector<std::pair<std::shared_ptr<wze::texture>, uint16_t>>&
-wze::animator::frames() {
-    return _frames;
+wze::animatable& wze::animatable::operator=(animatable const& other) {
+    if (&other != this) {
+        animator::copy(other, *this);
+    }
+
+    return *this;
 }
 
-std::vector<std::weak_ptr<wze::animatable>> const&
-wze::animator::targets() const {
-    return _targets;
+void wze::animator::erase(size_t index) {
+    size_t last;
+
+    --_tracks.clock[index]->_targets;
+    _indices.erase(_tracks.target[index]);
+
+    last = _tracks.target.size() - 1;
+    if (index != last) {
+        _tracks.target[index] = _tracks.target[last];
+        _tracks.clock[index] = _tracks.clock[last];
+        _tracks.phase[index] = _tracks.phase[last];
+        _tracks.frame[index] = _tracks.frame[last];
+        _indices[_tracks.target[index]] = index;
+    }
+
+    _tracks.target.pop_back();
+    _tracks.clock.pop_back();
+    _tracks.phase.pop_back();
+    _tracks.frame.pop_back();
 }
 
-std::vector<std::weak_ptr<wze::animatable>>& wze::animator::targets() {
-    return _targets;
+void wze::animator::advance() {
+    if (_dirty) {
+        _starts.clear();
+        _period = 0;
+        std::for_each(frames().begin(), frames().end(),
+                      [&](std::pair<texture_region, uint16_t> const& frame)
+                          -> void {
+                          _starts.push_back(_period);
+                          _period += frame.second;
+                      });
+    }
+
+    if (playing() && (bool)_period) {
+        _time += timer::delta_time();
+        if ((float)_period <= _time) {
+            _loops += (size_t)(_time / (float)_period);
+            _time = std::fmod(_time, (float)_period);
+        }
+    }
 }
 
-size_t wze::animator::current_frame() const {
-    return _current_frame;
+size_t wze::animator::frame(uint32_t time) const {
+    if (!(bool)_period) {
+        return 0;
+    }
+
+    return (size_t)(std::upper_bound(_starts.begin(), _starts.end(),
+                                     time % _period) -
+                    _starts.begin() - 1);
 }
 
-void wze::animator::set_current_frame(size_t current_frame) {
-    _current_frame = current_frame;
+void wze::animator::update() {
+    size_t index;
+    size_t shown;
+
+    std::for_each(_instances.begin(), _instances.end(),
+                  [](animator* instance) -> void { instance->advance(); });
+
+    for (index = 0; index != _tracks.target.size(); ++index) {
+        animator const& clock = *_tracks.clock[index];
+
+        if (clock.frames().empty()) {
+            continue;
+        }
+        if (clock._dirty) {
+            _tracks.frame[index] = std::numeric_limits<size_t>::max();
+        }
+
+        shown = clock.frame((uint32_t)clock.time() + _tracks.phase[index]);
+        if (shown != _tracks.frame[index] &&
+            _tracks.target[index]->animated()) {
+            _tracks.target[index]->set_region(clock.frames()[shown].first);
+            _tracks.frame[index] = shown;
+        }
+    }
+
+    std::for_each(_instances.begin(), _instances.end(),
+                  [](animator* instance) -> void {
+                      instance->_dirty = false;
+                  });
 }
 
-bool wze::animator::play() {
-    uint32_t elapsed_time;
-    bool looped;
+void wze::animator::release(animatable const* target) {
+    std::unordered_map<animatable const*, size_t>::const_iterator iterator;
 
-    if (frames().empty()) {
-        return false;
+    iterator = _indices.find(target);
+    if (iterator != _indices.end()) {
+        erase(iterator->second);
     }
+}
+
+void wze::animator::copy(animatable const& source, animatable& target) {
+    std::unordered_map<animatable const*, size_t>::const_iterator iterator;
 
-    if ((bool)frames().at(current_frame()).second) {
-        elapsed_time = (uint32_t)timer::delta_time() + _remaining_time;
-        set_current_frame(current_frame() +
-                          elapsed_time / frames().at(current_frame()).second);
-        _remaining_time = elapsed_time % frames().at(current_frame()).second;
-    } else {
-        set_current_frame(current_frame() + 1);
-        _remaining_time = 0;
+    iterator = _indices.find(&source);
+    if (iterator == _indices.end()) {
+        release(&target);
+        return;
     }
 
-    looped = frames().size() <= current_frame();
-    if (looped) {
-        set_current_frame(current_frame() % frames().size());
+    _tracks.clock[iterator->second]->attach(target,
+                                            _tracks.phase[iterator->second]);
+}
+
+wze::animator::animator(
+    std::vector<std::pair<texture_region, uint16_t>> const& frames) {
+    _instances.push_back(this);
+    _targets = 0;
+    set_frames(frames);
+    _period = 0;
+    set_time(0);
+    set_playing(true);
+    _loops = 0;
+}
+
+wze::animator::animator(animator const& other) {
+    _instances.push_back(this);
+    _targets = 0;
+    *this = other;
+}
+
+wze::animator::~animator() {
+    size_t index;
+
+    for (index = _tracks.target.size(); (bool)_targets && (bool)index;) {
+        --index;
+        if (_tracks.clock[index] == this) {
+            erase(index);
+        }
+    }
+
+    _instances.erase(std::find(_instances.begin(), _instances.end(), this));
+}
+
+wze::animator& wze::animator::operator=(animator const& other) {
+    if (&other != this) {
+        set_frames(other.frames());
+        _period = 0;
+        set_time(other.time());
+        set_playing(other.playing());
+        _loops = other.loops();
+    }
+
+    return *this;
+}
+
+std::vector<std::pair<wze::texture_region, uint16_t>> const&
+wze::animator::frames() const {
+    return _frames;
+}
+
+void wze::animator::set_frames(
+    std::vector<std::pair<texture_region, uint16_t>> const& frames) {
+    _frames = frames;
+    _dirty = true;
+}
+
+size_t wze::animator::targets() const {
+    return _targets;
+}
+
+void wze::animator::attach(animatable& target, uint32_t phase) {
+    release(&target);
+
+    _indices[&target] = _tracks.target.size();
+    _tracks.target.push_back(&target);
+    _tracks.clock.push_back(this);
+    _tracks.phase.push_back(phase);
+    _tracks.frame.push_back(std::numeric_limits<size_t>::max());
+    ++_targets;
+}
+
+void wze::animator::detach(animatable const& target) {
+    std::unordered_map<animatable const*, size_t>::const_iterator iterator;
+
+    iterator = _indices.find(&target);
+    if (iterator != _indices.end() &&
+        _tracks.clock[iterator->second] == this) {
+        erase(iterator->second);
     }
+}
 
-    targets().erase(
-        std::remove_if(targets().begin(), targets().end(),
-                       [&](std::weak_ptr<animatable> const& target) -> bool {
-                           std::shared_ptr<animatable> locked;
+float wze::animator::time() const {
+    return _time;
+}
+
+void wze::animator::set_time(float time) {
+    _time = time;
+}
+
+bool wze::animator::playing() const {
+    return _playing;
+}
 
-                           locked = target.lock();
-                           if (locked) {
-                               if (locked->animated()) {
-                                   locked->set_texture(
-                                       frames().at(current_frame()).first);
-                               }
-                               return false;
-                           }
+void wze::animator::set_playing(bool playing) {
+    _playing = playing;
+}
 
-                           return true;
-                       }),
-        targets().end());
+size_t wze::animator::loops() const {
+    return _loops;
+}
 
-    return looped;
+size_t wze::animator::current_frame() const {
+    return frame((uint32_t)time());
 }
 
 void wze::animator::reset() {
-    set_current_frame(0);
-    _remaining_time = 0;
+    set_time(0);
+    _loops = 0;
 }
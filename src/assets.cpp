@@ -24,24 +24,385 @@
 
 #include <wizard_engine/assets.hpp>
 #include <wizard_engine/exception.hpp>
+#include <wizard_engine/pack.hpp>
 #include <wizard_engine/renderer.hpp>
 
+bool wze::assets::_caching = true;
+std::unordered_map<std::string, std::weak_ptr<wze::image>>
+    wze::assets::_images = {};
+std::unordered_map<wze::image*, wze::assets::texture_entry>
+    wze::assets::_textures = {};
+std::unordered_map<uint64_t, std::weak_ptr<wze::texture>>
+    wze::assets::_digests = {};
+std::unordered_map<std::string, std::weak_ptr<wze::sound>>
+    wze::assets::_sounds = {};
+std::unordered_map<std::string, std::weak_ptr<wze::font>>
+    wze::assets::_fonts = {};
+wze::cache_stats wze::assets::_cache_stats = {};
+SDL_mutex* wze::assets::_mutex = {};
+SDL_sem* wze::assets::_queued = {};
+SDL_cond* wze::assets::_idle = {};
+size_t wze::assets::_loaders = {};
+std::deque<std::function<void()>> wze::assets::_jobs = {};
+std::vector<std::function<bool()>> wze::assets::_uploads = {};
+size_t wze::assets::_pending = {};
+size_t wze::assets::_completed = {};
+float wze::assets::_upload_budget = {};
+std::vector<std::pair<std::string, std::shared_ptr<wze::pack>>>
+    wze::assets::_packs = {};
+std::unordered_map<std::string, std::weak_ptr<wze::texture>>
+    wze::assets::_texture_files = {};
+
+std::string wze::assets::normalize(std::string const& path) {
+    return std::filesystem::path(_assets + path).lexically_normal().string();
+}
+
+template <typename asset>
+std::shared_ptr<asset> wze::assets::cached(
+    std::unordered_map<std::string, std::weak_ptr<asset>>& cache,
+    std::string const& key,
+    std::function<std::shared_ptr<asset>()> const& load) {
+    std::shared_ptr<asset> loaded;
+
+    if (!caching()) {
+        return load();
+    }
+
+    SDL_LockMutex(_mutex);
+    loaded = cache[key].lock();
+    if (loaded) {
+        ++_cache_stats.hits;
+    } else {
+        ++_cache_stats.misses;
+    }
+    SDL_UnlockMutex(_mutex);
+    if (loaded) {
+        return loaded;
+    }
+
+    loaded = load();
+    SDL_LockMutex(_mutex);
+    cache[key] = loaded;
+    SDL_UnlockMutex(_mutex);
+
+    return loaded;
+}
+
+std::shared_ptr<wze::pack> wze::assets::locate(std::string const& path) {
+    std::vector<std::pair<std::string, std::shared_ptr<pack>>>::reverse_iterator
+        iterator;
+    std::shared_ptr<pack> pack;
+
+    SDL_LockMutex(_mutex);
+    iterator = std::find_if(
+        _packs.rbegin(), _packs.rend(),
+        [&](std::pair<std::string, std::shared_ptr<wze::pack>> const& mounted)
+            -> bool {
+            return mounted.second->contains(path);
+        });
+    if (iterator != _packs.rend()) {
+        pack = iterator->second;
+    }
+    SDL_UnlockMutex(_mutex);
+
+    return pack;
+}
+
+int32_t wze::assets::work([[maybe_unused]] void* data) {
+    std::function<void()> job;
+
+    while (true) {
+        SDL_SemWait(_queued);
+        SDL_LockMutex(_mutex);
+        job = std::move(_jobs.front());
+        _jobs.pop_front();
+        SDL_UnlockMutex(_mutex);
+
+        job();
+
+        SDL_LockMutex(_mutex);
+        --_pending;
+        ++_completed;
+        SDL_CondBroadcast(_idle);
+        SDL_UnlockMutex(_mutex);
+    }
+}
+
+void wze::assets::schedule(std::function<void()> const& job) {
+    SDL_Thread* thread;
+
+    SDL_LockMutex(_mutex);
+    ++_pending;
+    for (; _loaders != _max_loaders; ++_loaders) {
+        thread = SDL_CreateThread(work, "wze_assets", nullptr);
+        if (!(bool)thread) {
+            break;
+        }
+        SDL_DetachThread(thread);
+    }
+
+    if (!(bool)_loaders) {
+        SDL_UnlockMutex(_mutex);
+        job();
+        SDL_LockMutex(_mutex);
+        --_pending;
+        ++_completed;
+        SDL_UnlockMutex(_mutex);
+        return;
+    }
+
+    _jobs.push_back(job);
+    SDL_UnlockMutex(_mutex);
+    SDL_SemPost(_queued);
+}
+
+template <typename asset>
+std::shared_future<std::shared_ptr<asset>>
+wze::assets::async(std::function<std::shared_ptr<asset>()> const& load) {
+    std::shared_ptr<std::promise<std::shared_ptr<asset>>> promise;
+    std::shared_future<std::shared_ptr<asset>> future;
+
+    promise = std::make_shared<std::promise<std::shared_ptr<asset>>>();
+    future = promise->get_future().share();
+    schedule([=]() -> void {
+        try {
+            promise->set_value(load());
+        } catch (...) {
+            promise->set_exception(std::current_exception());
+        }
+    });
+
+    return future;
+}
+
+bool wze::assets::caching() {
+    return _caching;
+}
+
+void wze::assets::set_caching(bool caching) {
+    _caching = caching;
+}
+
+size_t wze::assets::pending() {
+    size_t pending;
+
+    SDL_LockMutex(_mutex);
+    pending = _pending;
+    SDL_UnlockMutex(_mutex);
+
+    return pending + _uploads.size();
+}
+
+size_t wze::assets::completed() {
+    size_t completed;
+
+    SDL_LockMutex(_mutex);
+    completed = _completed;
+    SDL_UnlockMutex(_mutex);
+
+    return completed;
+}
+
+float wze::assets::upload_budget() {
+    return _upload_budget;
+}
+
+void wze::assets::set_upload_budget(float upload_budget) {
+    _upload_budget = upload_budget;
+}
+
+void wze::assets::mount(std::string const& path) {
+    std::shared_ptr<pack> pack;
+
+    pack = std::make_shared<wze::pack>(
+        std::filesystem::relative(_assets + path).string());
+    SDL_LockMutex(_mutex);
+    _packs.emplace_back(path, pack);
+    SDL_UnlockMutex(_mutex);
+}
+
+void wze::assets::unmount(std::string const& path) {
+    SDL_LockMutex(_mutex);
+    _packs.erase(
+        std::remove_if(
+            _packs.begin(), _packs.end(),
+            [&](std::pair<std::string, std::shared_ptr<pack>> const& mounted)
+                -> bool {
+                return mounted.first == path;
+            }),
+        _packs.end());
+    SDL_UnlockMutex(_mutex);
+}
+
+wze::cache_stats const& wze::assets::cache_stats() {
+    return _cache_stats;
+}
+
+void wze::assets::clear_cache() {
+    SDL_LockMutex(_mutex);
+    _images.clear();
+    _textures.clear();
+    _digests.clear();
+    _sounds.clear();
+    _fonts.clear();
+    _texture_files.clear();
+    _cache_stats = {};
+    SDL_UnlockMutex(_mutex);
+}
+
 void wze::assets::combine_hash(size_t& seed, size_t value) {
     // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
     seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
 }
 
-std::shared_ptr<wze::image> wze::assets::load_image(std::string const& path) {
-    std::shared_ptr<image> image;
+namespace {
+constexpr uint64_t prime1 = 11400714785074694791U;
+constexpr uint64_t prime2 = 14029467366897019727U;
+constexpr uint64_t prime3 = 1609587929392839161U;
+constexpr uint64_t prime4 = 9650029242287828579U;
+constexpr uint64_t prime5 = 2870177450012600261U;
 
-    image = {
-        IMG_Load(std::filesystem::relative(_assets + path).string().c_str()),
-        SDL_FreeSurface};
-    if (!image) {
-        throw exception(IMG_GetError());
+uint64_t rotate(uint64_t value, uint8_t bits) {
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+    return value << bits | value >> (64 - bits);
+}
+
+uint64_t round(uint64_t lane, uint64_t input) {
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+    return rotate(lane + input * prime2, 31) * prime1;
+}
+
+uint64_t merge(uint64_t hash, uint64_t lane) {
+    return (hash ^ round(0, lane)) * prime1 + prime4;
+}
+
+template <typename word> word load(uint8_t const* data) {
+    word value;
+
+    std::memcpy(&value, data, sizeof(value));
+
+    return value;
+}
+} /* namespace */
+
+wze::assets::digest_state wze::assets::begin_digest() {
+    return {{prime1 + prime2, prime2, 0, 0 - prime1}, {}, 0, 0};
+}
+
+void wze::assets::update_digest(digest_state& state, void const* data,
+                                size_t size) {
+    uint8_t const* bytes;
+    size_t copied;
+
+    bytes = static_cast<uint8_t const*>(data);
+    state.length += size;
+
+    if ((bool)state.buffered) {
+        copied = std::min(size, state.buffer.size() - state.buffered);
+        std::memcpy(state.buffer.data() + state.buffered, bytes, copied);
+        state.buffered += copied;
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        bytes += copied;
+        size -= copied;
+        if (state.buffered != state.buffer.size()) {
+            return;
+        }
+        state.lanes = {
+            round(state.lanes[0], load<uint64_t>(state.buffer.data())),
+            // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+            round(state.lanes[1], load<uint64_t>(state.buffer.data() + 8)),
+            // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+            round(state.lanes[2], load<uint64_t>(state.buffer.data() + 16)),
+            // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+            round(state.lanes[3], load<uint64_t>(state.buffer.data() + 24))};
+        state.buffered = 0;
     }
 
-    return image;
+    for (; state.buffer.size() <= size;
+         // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+         bytes += state.buffer.size(), size -= state.buffer.size()) {
+        state.lanes = {
+            round(state.lanes[0], load<uint64_t>(bytes)),
+            // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers,cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            round(state.lanes[1], load<uint64_t>(bytes + 8)),
+            // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers,cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            round(state.lanes[2], load<uint64_t>(bytes + 16)),
+            // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers,cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            round(state.lanes[3], load<uint64_t>(bytes + 24))};
+    }
+
+    std::memcpy(state.buffer.data(), bytes, size);
+    state.buffered = size;
+}
+
+uint64_t wze::assets::end_digest(digest_state const& state) {
+    uint64_t hash;
+    size_t index;
+
+    if (state.buffer.size() <= state.length) {
+        // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+        hash = rotate(state.lanes[0], 1) + rotate(state.lanes[1], 7) +
+               rotate(state.lanes[2], 12) + rotate(state.lanes[3], 18);
+        // NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
+        hash = merge(hash, state.lanes[0]);
+        hash = merge(hash, state.lanes[1]);
+        hash = merge(hash, state.lanes[2]);
+        hash = merge(hash, state.lanes[3]);
+    } else {
+        hash = prime5;
+    }
+    hash += state.length;
+
+    // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers,cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    for (index = 0; index + 8 <= state.buffered; index += 8) {
+        hash ^= round(0, load<uint64_t>(state.buffer.data() + index));
+        hash = rotate(hash, 27) * prime1 + prime4;
+    }
+    if (index + 4 <= state.buffered) {
+        hash ^= load<uint32_t>(state.buffer.data() + index) * prime1;
+        hash = rotate(hash, 23) * prime2 + prime3;
+        index += 4;
+    }
+    for (; index != state.buffered; ++index) {
+        hash ^= state.buffer[index] * prime5;
+        hash = rotate(hash, 11) * prime1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= prime2;
+    hash ^= hash >> 29;
+    hash *= prime3;
+    hash ^= hash >> 32;
+    // NOLINTEND(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers,cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+    return hash;
+}
+
+std::shared_ptr<wze::image> wze::assets::load_image(std::string const& path) {
+    return cached<image>(
+        _images, normalize(path), [&]() -> std::shared_ptr<image> {
+            std::shared_ptr<image> image;
+            std::shared_ptr<pack> pack;
+
+            pack = locate(path);
+            image = {pack ? IMG_Load_RW(pack->open(path), 1)
+                          : IMG_Load(std::filesystem::relative(_assets + path)
+                                         .string()
+                                         .c_str()),
+                     SDL_FreeSurface};
+            if (!image) {
+                throw exception(IMG_GetError());
+            }
+
+            return image;
+        });
+}
+
+std::shared_future<std::shared_ptr<wze::image>>
+wze::assets::load_image_async(std::string const& path) {
+    return async<image>([=]() -> std::shared_ptr<image> {
+        return load_image(path);
+    });
 }
 
 std::shared_ptr<wze::image>
@@ -85,30 +446,282 @@ size_t wze::assets::hash_image(std::shared_ptr<image> const& image) {
     return seed;
 }
 
+uint64_t wze::assets::digest_image(std::shared_ptr<image> const& image) {
+    digest_state state;
+    std::array<uint32_t, 3> header;
+    int32_t row;
+
+    state = begin_digest();
+    if (!image) {
+        return end_digest(state);
+    }
+
+    header = {(uint32_t)image->w, (uint32_t)image->h, image->format->format};
+    update_digest(state, header.data(), sizeof(header));
+    for (row = 0; row != image->h; ++row) {
+        update_digest(state,
+                      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                      static_cast<uint8_t const*>(image->pixels) +
+                          (std::ptrdiff_t)row * image->pitch,
+                      (size_t)image->w * image->format->BytesPerPixel);
+    }
+
+    return end_digest(state);
+}
+
 std::shared_ptr<wze::texture>
 wze::assets::create_texture(std::shared_ptr<image> const& image) {
+    bool cache;
+    uint64_t digest;
+    std::unordered_map<wze::image*, texture_entry>::iterator iterator;
+    std::unordered_map<uint64_t, std::weak_ptr<wze::texture>>::iterator
+        duplicate;
     std::shared_ptr<texture> texture;
 
+    cache = caching() && image;
+    digest = 0;
+    if (cache) {
+        SDL_LockMutex(_mutex);
+        iterator = _textures.find(image.get());
+        if (iterator != _textures.end()) {
+            if (iterator->second.image.lock() == image) {
+                texture = iterator->second.texture.lock();
+            }
+            if (!texture) {
+                _textures.erase(iterator);
+            }
+        }
+        if (texture) {
+            ++_cache_stats.hits;
+        }
+        SDL_UnlockMutex(_mutex);
+        if (texture) {
+            return texture;
+        }
+
+        digest = digest_image(image);
+        SDL_LockMutex(_mutex);
+        duplicate = _digests.find(digest);
+        if (duplicate != _digests.end()) {
+            texture = duplicate->second.lock();
+            if (texture) {
+                _textures[image.get()] = {image, texture};
+            } else {
+                _digests.erase(duplicate);
+            }
+        }
+        if (texture) {
+            ++_cache_stats.hits;
+        } else {
+            ++_cache_stats.misses;
+        }
+        SDL_UnlockMutex(_mutex);
+        if (texture) {
+            return texture;
+        }
+    }
+
     texture = {SDL_CreateTextureFromSurface(renderer::base(), image.get()),
-               SDL_DestroyTexture};
+               renderer::release};
     if (!texture) {
         throw exception(SDL_GetError());
     }
 
+    if (cache) {
+        SDL_LockMutex(_mutex);
+        for (iterator = _textures.begin(); iterator != _textures.end();) {
+            if (iterator->second.image.expired() ||
+                iterator->second.texture.expired()) {
+                iterator = _textures.erase(iterator);
+            } else {
+                ++iterator;
+            }
+        }
+        for (duplicate = _digests.begin(); duplicate != _digests.end();) {
+            if (duplicate->second.expired()) {
+                duplicate = _digests.erase(duplicate);
+            } else {
+                ++duplicate;
+            }
+        }
+        _textures[image.get()] = {image, texture};
+        _digests[digest] = texture;
+        SDL_UnlockMutex(_mutex);
+    }
+
     return texture;
 }
 
-std::shared_ptr<wze::sound> wze::assets::load_sound(std::string const& path) {
-    std::shared_ptr<sound> sound;
+std::shared_future<std::shared_ptr<wze::texture>>
+wze::assets::create_texture_async(
+    std::shared_future<std::shared_ptr<image>> const& image) {
+    std::shared_ptr<std::promise<std::shared_ptr<texture>>> promise;
+    std::shared_future<std::shared_ptr<texture>> future;
+
+    promise = std::make_shared<std::promise<std::shared_ptr<texture>>>();
+    future = promise->get_future().share();
+    _uploads.emplace_back([=]() -> bool {
+        if (image.wait_for(std::chrono::seconds::zero()) !=
+            std::future_status::ready) {
+            return false;
+        }
+        try {
+            promise->set_value(create_texture(image.get()));
+        } catch (...) {
+            promise->set_exception(std::current_exception());
+        }
+        return true;
+    });
+
+    return future;
+}
 
-    sound = {
-        Mix_LoadWAV(std::filesystem::relative(_assets + path).string().c_str()),
-        Mix_FreeChunk};
-    if (!sound) {
-        throw exception(Mix_GetError());
+void wze::assets::save_texture(std::shared_ptr<image> const& image,
+                               std::string const& path, bool premultiplied) {
+    constexpr uint32_t bytes_per_pixel = 4;
+
+    SDL_RendererInfo info;
+    uint32_t format;
+    std::unique_ptr<wze::image, std::function<void(wze::image*)>> converted;
+    texture_header header;
+    std::unique_ptr<SDL_RWops, std::function<void(SDL_RWops*)>> stream;
+    int32_t row;
+
+    format = !(bool)SDL_GetRendererInfo(renderer::base(), &info) &&
+                     (bool)info.num_texture_formats &&
+                     SDL_ISPIXELFORMAT_ALPHA(info.texture_formats[0]) &&
+                     SDL_BYTESPERPIXEL(info.texture_formats[0]) ==
+                         bytes_per_pixel
+                 ? info.texture_formats[0]
+                 : (uint32_t)SDL_PIXELFORMAT_ARGB8888;
+    converted = {SDL_ConvertSurfaceFormat(image.get(), format, 0),
+                 SDL_FreeSurface};
+    if (!converted ||
+        (premultiplied &&
+         (bool)SDL_PremultiplyAlpha(converted->w, converted->h, format,
+                                    converted->pixels, converted->pitch,
+                                    format, converted->pixels,
+                                    converted->pitch))) {
+        throw exception(SDL_GetError());
     }
 
-    return sound;
+    header = {_texture_magic, format, (uint32_t)converted->w,
+              (uint32_t)converted->h, premultiplied ? _premultiplied : 0};
+    stream = {SDL_RWFromFile(
+                  std::filesystem::relative(_assets + path).string().c_str(),
+                  "wb"),
+              SDL_RWclose};
+    if (!stream || SDL_RWwrite(stream.get(), &header, sizeof(header), 1) != 1) {
+        throw exception(SDL_GetError());
+    }
+    for (row = 0; row != converted->h; ++row) {
+        if (SDL_RWwrite(stream.get(),
+                        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                        static_cast<uint8_t*>(converted->pixels) +
+                            (std::ptrdiff_t)row * converted->pitch,
+                        (size_t)converted->w * bytes_per_pixel,
+                        1) != 1) {
+            throw exception(SDL_GetError());
+        }
+    }
+}
+
+std::shared_ptr<wze::texture>
+wze::assets::load_texture(std::string const& path) {
+    return cached<texture>(
+        _texture_files, normalize(path), [&]() -> std::shared_ptr<texture> {
+            constexpr uint32_t bytes_per_pixel = 4;
+
+            std::shared_ptr<pack> pack;
+            std::pair<uint8_t const*, size_t> contents;
+            std::unique_ptr<uint8_t, std::function<void(uint8_t*)>> file;
+            texture_header header;
+            std::shared_ptr<texture> texture;
+
+            pack = locate(path);
+            if (pack) {
+                contents = pack->view(path);
+            } else {
+                file = {static_cast<uint8_t*>(SDL_LoadFile(
+                            std::filesystem::relative(_assets + path)
+                                .string()
+                                .c_str(),
+                            &contents.second)),
+                        [](uint8_t* data) -> void {
+                            SDL_free(data);
+                        }};
+                if (!file) {
+                    throw exception(SDL_GetError());
+                }
+                contents.first = file.get();
+            }
+
+            if (contents.second < sizeof(header)) {
+                throw exception("Malformed texture " + path);
+            }
+            std::memcpy(&header, contents.first, sizeof(header));
+            if (header.magic != _texture_magic ||
+                SDL_BYTESPERPIXEL(header.format) != bytes_per_pixel ||
+                (contents.second - sizeof(header)) / bytes_per_pixel /
+                        std::max(header.width, (uint32_t)1) <
+                    header.height) {
+                throw exception("Malformed texture " + path);
+            }
+
+            texture = {SDL_CreateTexture(renderer::base(), header.format,
+                                         SDL_TEXTUREACCESS_STATIC,
+                                         (int32_t)header.width,
+                                         (int32_t)header.height),
+                       renderer::release};
+            if (!texture ||
+                (bool)SDL_UpdateTexture(
+                    texture.get(), nullptr,
+                    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                    contents.first + sizeof(header),
+                    (int32_t)(header.width * bytes_per_pixel)) ||
+                (bool)SDL_SetTextureBlendMode(
+                    texture.get(),
+                    (bool)(header.flags & _premultiplied)
+                        ? SDL_ComposeCustomBlendMode(
+                              SDL_BLENDFACTOR_ONE,
+                              SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA,
+                              SDL_BLENDOPERATION_ADD, SDL_BLENDFACTOR_ONE,
+                              SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA,
+                              SDL_BLENDOPERATION_ADD)
+                        : SDL_BLENDMODE_BLEND)) {
+                throw exception(SDL_GetError());
+            }
+
+            return texture;
+        });
+}
+
+std::shared_ptr<wze::sound> wze::assets::load_sound(std::string const& path) {
+    return cached<sound>(
+        _sounds, normalize(path), [&]() -> std::shared_ptr<sound> {
+            std::shared_ptr<sound> sound;
+            std::shared_ptr<pack> pack;
+
+            pack = locate(path);
+            sound = {pack ? Mix_LoadWAV_RW(pack->open(path), 1)
+                          : Mix_LoadWAV(
+                                std::filesystem::relative(_assets + path)
+                                    .string()
+                                    .c_str()),
+                     Mix_FreeChunk};
+            if (!sound) {
+                throw exception(Mix_GetError());
+            }
+
+            return sound;
+        });
+}
+
+std::shared_future<std::shared_ptr<wze::sound>>
+wze::assets::load_sound_async(std::string const& path) {
+    return async<sound>([=]() -> std::shared_ptr<sound> {
+        return load_sound(path);
+    });
 }
 
 size_t wze::assets::hash_sound(std::shared_ptr<sound> const& sound) {
@@ -129,24 +742,60 @@ size_t wze::assets::hash_sound(std::shared_ptr<sound> const& sound) {
     return seed;
 }
 
+uint64_t wze::assets::digest_sound(std::shared_ptr<sound> const& sound) {
+    digest_state state;
+
+    state = begin_digest();
+    if (sound) {
+        update_digest(state, sound->abuf, sound->alen);
+    }
+
+    return end_digest(state);
+}
+
 std::shared_ptr<wze::font> wze::assets::load_font(std::string const& path,
                                                   uint8_t size,
                                                   font_style style,
                                                   font_alignment alignment) {
-    std::shared_ptr<font> font;
-
-    font = {
-        TTF_OpenFont(std::filesystem::relative(_assets + path).string().c_str(),
-                     size),
-        TTF_CloseFont};
-    if (!font) {
-        throw exception(TTF_GetError());
-    }
-    TTF_SetFontStyle(font.get(), style);
-    TTF_SetFontWrappedAlign(font.get(), alignment);
-    TTF_SetFontHinting(font.get(), TTF_HINTING_LIGHT_SUBPIXEL);
+    return cached<font>(
+        _fonts,
+        normalize(path) + '\0' + std::to_string(size) + '\0' +
+            std::to_string(style) + '\0' + std::to_string(alignment),
+        [&]() -> std::shared_ptr<font> {
+            std::shared_ptr<font> font;
+            std::shared_ptr<pack> pack;
+
+            pack = locate(path);
+            SDL_LockMutex(_mutex);
+            font = {pack ? TTF_OpenFontRW(pack->open(path), 1, size)
+                         : TTF_OpenFont(
+                               std::filesystem::relative(_assets + path)
+                                   .string()
+                                   .c_str(),
+                               size),
+                    [pack](wze::font* font) -> void {
+                        SDL_LockMutex(_mutex);
+                        TTF_CloseFont(font);
+                        SDL_UnlockMutex(_mutex);
+                    }};
+            SDL_UnlockMutex(_mutex);
+            if (!font) {
+                throw exception(TTF_GetError());
+            }
+            TTF_SetFontStyle(font.get(), style);
+            TTF_SetFontWrappedAlign(font.get(), alignment);
+            TTF_SetFontHinting(font.get(), TTF_HINTING_LIGHT_SUBPIXEL);
+
+            return font;
+        });
+}
 
-    return font;
+std::shared_future<std::shared_ptr<wze::font>>
+wze::assets::load_font_async(std::string const& path, uint8_t size,
+                             font_style style, font_alignment alignment) {
+    return async<font>([=]() -> std::shared_ptr<font> {
+        return load_font(path, size, style, alignment);
+    });
 }
 
 std::unique_ptr<wze::cursor, std::function<void(wze::cursor*)>>
@@ -174,3 +823,46 @@ wze::assets::create_cursor(std::shared_ptr<image> const& image, uint16_t hot_x,
 
     return cursor;
 }
+
+void wze::assets::initialize() {
+    _mutex = SDL_CreateMutex();
+    _queued = SDL_CreateSemaphore(0);
+    _idle = SDL_CreateCond();
+    if (!(bool)_mutex || !(bool)_queued || !(bool)_idle) {
+        throw exception(SDL_GetError());
+    }
+    if ((bool)std::atexit([]() -> void {
+            SDL_LockMutex(_mutex);
+            while ((bool)_pending) {
+                SDL_CondWait(_idle, _mutex);
+            }
+            SDL_UnlockMutex(_mutex);
+        })) {
+        throw exception("Cannot register the loaders for shutdown");
+    }
+    set_upload_budget(2);
+}
+
+void wze::assets::update() {
+    constexpr float milliseconds = 1000;
+
+    uint64_t start;
+    size_t upload;
+
+    start = SDL_GetPerformanceCounter();
+    for (upload = 0; upload != _uploads.size();) {
+        if (_uploads[upload]()) {
+            _uploads.erase(_uploads.begin() + (std::ptrdiff_t)upload);
+            SDL_LockMutex(_mutex);
+            ++_completed;
+            SDL_UnlockMutex(_mutex);
+            if (upload_budget() <=
+                (float)(SDL_GetPerformanceCounter() - start) * milliseconds /
+                    (float)SDL_GetPerformanceFrequency()) {
+                return;
+            }
+        } else {
+            ++upload;
+        }
+    }
+}
@@ -26,6 +26,12 @@
 #include <wizard_engine/math.hpp>
 #include <wizard_engine/window.hpp>
 
+#if defined(__x86_64__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 float wze::camera::_x = {};
 float wze::camera::_y = {};
 float wze::camera::_z = {};
@@ -78,6 +84,10 @@ void wze::camera::set_focus(float focus) {
     _focus = focus;
 }
 
+wze::camera_view wze::camera::capture() {
+    return {x(), y(), z(), angle(), focus(), transformation_matrix()};
+}
+
 void wze::camera::initialize() {
     constexpr float field_of_view = math::to_radians(90);
 
@@ -89,45 +99,402 @@ void wze::camera::initialize() {
               (2 * tanf(field_of_view / 2)));
 }
 
-void wze::camera::project(renderable& instance) {
+// Keeps -ffast-math from reassociating or contracting the projections
+// differently in the scalar and vector code paths, so that they stay
+// bit-compatible. The pragma only covers clang, the build also compiles this
+// file with -fno-associative-math and -ffp-contract=off. The scalar path does
+// its arithmetic here instead of calling the inline helpers of math.hpp.
+#ifdef __clang__
+#pragma float_control(precise, on, push)
+#endif /* __clang__ */
+
+#if defined(__x86_64__)
+static inline __m128 load_flags(uint8_t const* flags) {
+    __m128i zero;
+    __m128i values;
+
+    zero = _mm_setzero_si128();
+    values = _mm_unpacklo_epi16(
+        _mm_unpacklo_epi8(_mm_loadu_si32(flags), zero), zero);
+    return _mm_castsi128_ps(_mm_cmpgt_epi32(values, zero));
+}
+
+static inline __m128 blend(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+size_t wze::camera::project_sse2(camera_view const& view,
+                                 render_proxies& proxies, size_t first,
+                                 size_t last) {
+    constexpr size_t lanes = 4;
+    __m128 one;
+    __m128 camera_x;
+    __m128 camera_y;
+    __m128 camera_z;
+    __m128 camera_angle;
+    __m128 camera_focus;
+    std::array<__m128, 4> matrix;
+    __m128 drawn;
+    __m128 spatial;
+    __m128 anchored;
+    __m128 focused;
+    __m128 x;
+    __m128 y;
+    __m128 z;
+    __m128 width;
+    __m128 height;
+    __m128 angle;
+    __m128 scale;
+    std::array<__m128, 4> area;
+    std::array<__m128, 4> previous;
+    size_t lane;
+
+    one = _mm_set1_ps(1);
+    camera_x = _mm_set1_ps(view.x);
+    camera_y = _mm_set1_ps(view.y);
+    camera_z = _mm_set1_ps(view.z);
+    camera_angle = _mm_set1_ps(view.angle);
+    camera_focus = _mm_set1_ps(view.focus);
+    for (lane = 0; lane != matrix.size(); ++lane) {
+        matrix.at(lane) = _mm_set1_ps(view.transformation_matrix.at(lane));
+    }
+
+    for (; first + lanes <= last; first += lanes) {
+        drawn = load_flags(&proxies.drawn[first]);
+        if (!(bool)_mm_movemask_ps(drawn)) {
+            continue;
+        }
+        spatial = load_flags(&proxies.spatial[first]);
+        x = _mm_loadu_ps(&proxies.x[first]);
+        y = _mm_loadu_ps(&proxies.y[first]);
+        z = _mm_loadu_ps(&proxies.z[first]);
+        width = _mm_loadu_ps(&proxies.width[first]);
+        height = _mm_loadu_ps(&proxies.height[first]);
+        angle = _mm_loadu_ps(&proxies.angle[first]);
+
+        anchored = _mm_cmpeq_ps(z, camera_z);
+        z = _mm_sub_ps(z, camera_z);
+        focused = _mm_cmpeq_ps(z, camera_focus);
+        scale = blend(focused, one,
+                      _mm_div_ps(camera_focus, blend(anchored, one, z)));
+        area.at(2) = _mm_mul_ps(_mm_sub_ps(x, camera_x), scale);
+        area.at(3) = _mm_mul_ps(_mm_sub_ps(y, camera_y), scale);
+        area.at(0) = _mm_add_ps(_mm_mul_ps(area.at(2), matrix.at(0)),
+                                _mm_mul_ps(area.at(3), matrix.at(1)));
+        area.at(1) = _mm_add_ps(_mm_mul_ps(area.at(2), matrix.at(2)),
+                                _mm_mul_ps(area.at(3), matrix.at(3)));
+        area.at(2) = _mm_mul_ps(width, scale);
+        area.at(3) = _mm_mul_ps(height, scale);
+        for (lane = 0; lane != area.size(); ++lane) {
+            area.at(lane) = _mm_andnot_ps(anchored, area.at(lane));
+        }
+        area.at(0) = blend(spatial, area.at(0), x);
+        area.at(1) = blend(spatial, area.at(1), y);
+        area.at(2) = blend(spatial, area.at(2), width);
+        area.at(3) = blend(spatial, area.at(3), height);
+
+        for (lane = 0; lane != lanes; ++lane) {
+            previous.at(lane) =
+                _mm_loadu_ps(&proxies.screen_area[first + lane].x);
+        }
+        _MM_TRANSPOSE4_PS(previous.at(0), previous.at(1), previous.at(2),
+                          previous.at(3));
+        for (lane = 0; lane != area.size(); ++lane) {
+            area.at(lane) = blend(drawn, area.at(lane), previous.at(lane));
+        }
+        _MM_TRANSPOSE4_PS(area.at(0), area.at(1), area.at(2), area.at(3));
+        for (lane = 0; lane != lanes; ++lane) {
+            _mm_storeu_ps(&proxies.screen_area[first + lane].x, area.at(lane));
+        }
+
+        _mm_storeu_ps(
+            &proxies.screen_angle[first],
+            blend(drawn, blend(spatial, _mm_sub_ps(angle, camera_angle), angle),
+                  _mm_loadu_ps(&proxies.screen_angle[first])));
+    }
+
+    return first;
+}
+
+__attribute__((target("avx2"))) size_t
+wze::camera::project_avx2(camera_view const& view, render_proxies& proxies,
+                          size_t first, size_t last) {
+    constexpr size_t lanes = 8;
+    __m256 one;
+    __m256 camera_x;
+    __m256 camera_y;
+    __m256 camera_z;
+    __m256 camera_angle;
+    __m256 camera_focus;
+    std::array<__m256, 4> matrix;
+    __m256 drawn;
+    __m256 spatial;
+    __m256 anchored;
+    __m256 focused;
+    __m256 x;
+    __m256 y;
+    __m256 z;
+    __m256 width;
+    __m256 height;
+    __m256 angle;
+    __m256 scale;
+    std::array<__m256, 4> area;
+    std::array<__m128, 4> half;
+    std::array<__m128, 4> previous;
+    __m128 mask;
+    __m256i zero;
+    size_t lane;
+    size_t offset;
+
+    zero = _mm256_setzero_si256();
+    one = _mm256_set1_ps(1);
+    camera_x = _mm256_set1_ps(view.x);
+    camera_y = _mm256_set1_ps(view.y);
+    camera_z = _mm256_set1_ps(view.z);
+    camera_angle = _mm256_set1_ps(view.angle);
+    camera_focus = _mm256_set1_ps(view.focus);
+    for (lane = 0; lane != matrix.size(); ++lane) {
+        matrix.at(lane) = _mm256_set1_ps(view.transformation_matrix.at(lane));
+    }
+
+    for (; first + lanes <= last; first += lanes) {
+        drawn = _mm256_castsi256_ps(_mm256_cmpgt_epi32(
+            _mm256_cvtepu8_epi32(
+                _mm_loadl_epi64((__m128i const*)&proxies.drawn[first])),
+            zero));
+        if (!(bool)_mm256_movemask_ps(drawn)) {
+            continue;
+        }
+        spatial = _mm256_castsi256_ps(_mm256_cmpgt_epi32(
+            _mm256_cvtepu8_epi32(
+                _mm_loadl_epi64((__m128i const*)&proxies.spatial[first])),
+            zero));
+        x = _mm256_loadu_ps(&proxies.x[first]);
+        y = _mm256_loadu_ps(&proxies.y[first]);
+        z = _mm256_loadu_ps(&proxies.z[first]);
+        width = _mm256_loadu_ps(&proxies.width[first]);
+        height = _mm256_loadu_ps(&proxies.height[first]);
+        angle = _mm256_loadu_ps(&proxies.angle[first]);
+
+        anchored = _mm256_cmp_ps(z, camera_z, _CMP_EQ_OQ);
+        z = _mm256_sub_ps(z, camera_z);
+        focused = _mm256_cmp_ps(z, camera_focus, _CMP_EQ_OQ);
+        scale = _mm256_blendv_ps(
+            _mm256_div_ps(camera_focus, _mm256_blendv_ps(z, one, anchored)),
+            one, focused);
+        area.at(2) = _mm256_mul_ps(_mm256_sub_ps(x, camera_x), scale);
+        area.at(3) = _mm256_mul_ps(_mm256_sub_ps(y, camera_y), scale);
+        area.at(0) = _mm256_add_ps(_mm256_mul_ps(area.at(2), matrix.at(0)),
+                                   _mm256_mul_ps(area.at(3), matrix.at(1)));
+        area.at(1) = _mm256_add_ps(_mm256_mul_ps(area.at(2), matrix.at(2)),
+                                   _mm256_mul_ps(area.at(3), matrix.at(3)));
+        area.at(2) = _mm256_mul_ps(width, scale);
+        area.at(3) = _mm256_mul_ps(height, scale);
+        for (lane = 0; lane != area.size(); ++lane) {
+            area.at(lane) = _mm256_andnot_ps(anchored, area.at(lane));
+        }
+        area.at(0) = _mm256_blendv_ps(x, area.at(0), spatial);
+        area.at(1) = _mm256_blendv_ps(y, area.at(1), spatial);
+        area.at(2) = _mm256_blendv_ps(width, area.at(2), spatial);
+        area.at(3) = _mm256_blendv_ps(height, area.at(3), spatial);
+
+        for (offset = 0; offset != lanes; offset += lanes / 2) {
+            for (lane = 0; lane != half.size(); ++lane) {
+                half.at(lane) = offset == 0
+                                    ? _mm256_castps256_ps128(area.at(lane))
+                                    : _mm256_extractf128_ps(area.at(lane), 1);
+                previous.at(lane) = _mm_loadu_ps(
+                    &proxies.screen_area[first + offset + lane].x);
+            }
+            mask = offset == 0 ? _mm256_castps256_ps128(drawn)
+                               : _mm256_extractf128_ps(drawn, 1);
+            _MM_TRANSPOSE4_PS(previous.at(0), previous.at(1), previous.at(2),
+                              previous.at(3));
+            for (lane = 0; lane != half.size(); ++lane) {
+                half.at(lane) =
+                    _mm_blendv_ps(previous.at(lane), half.at(lane), mask);
+            }
+            _MM_TRANSPOSE4_PS(half.at(0), half.at(1), half.at(2), half.at(3));
+            for (lane = 0; lane != half.size(); ++lane) {
+                _mm_storeu_ps(&proxies.screen_area[first + offset + lane].x,
+                              half.at(lane));
+            }
+        }
+
+        _mm256_storeu_ps(
+            &proxies.screen_angle[first],
+            _mm256_blendv_ps(
+                _mm256_loadu_ps(&proxies.screen_angle[first]),
+                _mm256_blendv_ps(angle, _mm256_sub_ps(angle, camera_angle),
+                                 spatial),
+                drawn));
+    }
+
+    return first;
+}
+#elif defined(__aarch64__)
+static inline uint32x4_t load_flags(uint8_t const* flags) {
+    std::array<uint32_t, 4> values;
+
+    std::copy(flags, flags + values.size(), values.begin());
+    return vcgtq_u32(vld1q_u32(values.data()), vdupq_n_u32(0));
+}
+
+size_t wze::camera::project_neon(camera_view const& view,
+                                 render_proxies& proxies, size_t first,
+                                 size_t last) {
+    constexpr size_t lanes = 4;
+    float32x4_t zero;
+    float32x4_t one;
+    float32x4_t camera_x;
+    float32x4_t camera_y;
+    float32x4_t camera_z;
+    float32x4_t camera_angle;
+    float32x4_t camera_focus;
+    std::array<float32x4_t, 4> matrix;
+    uint32x4_t drawn;
+    uint32x4_t spatial;
+    uint32x4_t anchored;
+    uint32x4_t focused;
+    float32x4_t x;
+    float32x4_t y;
+    float32x4_t z;
+    float32x4_t width;
+    float32x4_t height;
+    float32x4_t angle;
+    float32x4_t scale;
+    float32x4x4_t area;
+    float32x4x4_t previous;
+    size_t lane;
+
+    zero = vdupq_n_f32(0);
+    one = vdupq_n_f32(1);
+    camera_x = vdupq_n_f32(view.x);
+    camera_y = vdupq_n_f32(view.y);
+    camera_z = vdupq_n_f32(view.z);
+    camera_angle = vdupq_n_f32(view.angle);
+    camera_focus = vdupq_n_f32(view.focus);
+    for (lane = 0; lane != matrix.size(); ++lane) {
+        matrix.at(lane) = vdupq_n_f32(view.transformation_matrix.at(lane));
+    }
+
+    for (; first + lanes <= last; first += lanes) {
+        drawn = load_flags(&proxies.drawn[first]);
+        if (!(bool)vmaxvq_u32(drawn)) {
+            continue;
+        }
+        spatial = load_flags(&proxies.spatial[first]);
+        x = vld1q_f32(&proxies.x[first]);
+        y = vld1q_f32(&proxies.y[first]);
+        z = vld1q_f32(&proxies.z[first]);
+        width = vld1q_f32(&proxies.width[first]);
+        height = vld1q_f32(&proxies.height[first]);
+        angle = vld1q_f32(&proxies.angle[first]);
+
+        anchored = vceqq_f32(z, camera_z);
+        z = vsubq_f32(z, camera_z);
+        focused = vceqq_f32(z, camera_focus);
+        scale = vbslq_f32(focused, one,
+                          vdivq_f32(camera_focus, vbslq_f32(anchored, one, z)));
+        area.val[2] = vmulq_f32(vsubq_f32(x, camera_x), scale);
+        area.val[3] = vmulq_f32(vsubq_f32(y, camera_y), scale);
+        area.val[0] = vaddq_f32(vmulq_f32(area.val[2], matrix.at(0)),
+                                vmulq_f32(area.val[3], matrix.at(1)));
+        area.val[1] = vaddq_f32(vmulq_f32(area.val[2], matrix.at(2)),
+                                vmulq_f32(area.val[3], matrix.at(3)));
+        area.val[2] = vmulq_f32(width, scale);
+        area.val[3] = vmulq_f32(height, scale);
+        for (lane = 0; lane != lanes; ++lane) {
+            area.val[lane] = vbslq_f32(anchored, zero, area.val[lane]);
+        }
+        area.val[0] = vbslq_f32(spatial, area.val[0], x);
+        area.val[1] = vbslq_f32(spatial, area.val[1], y);
+        area.val[2] = vbslq_f32(spatial, area.val[2], width);
+        area.val[3] = vbslq_f32(spatial, area.val[3], height);
+
+        previous = vld4q_f32(&proxies.screen_area[first].x);
+        for (lane = 0; lane != lanes; ++lane) {
+            area.val[lane] =
+                vbslq_f32(drawn, area.val[lane], previous.val[lane]);
+        }
+        vst4q_f32(&proxies.screen_area[first].x, area);
+
+        vst1q_f32(&proxies.screen_angle[first],
+                  vbslq_f32(drawn,
+                            vbslq_f32(spatial, vsubq_f32(angle, camera_angle),
+                                      angle),
+                            vld1q_f32(&proxies.screen_angle[first])));
+    }
+
+    return first;
+}
+#endif
+
+void wze::camera::project(camera_view const& view, render_proxies& proxies,
+                          size_t proxy) {
     float x;
     float y;
     float z;
-
-    if (!instance.spatial()) {
-        instance.set_screen_area(
-            {instance.x(), instance.y(), instance.width(), instance.height()});
-        instance.set_screen_angle(instance.angle());
+    float transformed_x;
+    float transformed_y;
+
+    if (!(bool)proxies.spatial[proxy]) {
+        proxies.screen_area[proxy] = {proxies.x[proxy], proxies.y[proxy],
+                                      proxies.width[proxy],
+                                      proxies.height[proxy]};
+        proxies.screen_angle[proxy] = proxies.angle[proxy];
         return;
     }
 
-    instance.set_screen_angle(instance.angle() - angle());
+    proxies.screen_angle[proxy] = proxies.angle[proxy] - view.angle;
 
-    if (instance.z() == camera::z()) {
-        instance.set_screen_area({0, 0, 0, 0});
+    if (proxies.z[proxy] == view.z) {
+        proxies.screen_area[proxy] = {0, 0, 0, 0};
         return;
     }
 
-    x = instance.x() - camera::x();
-    y = instance.y() - camera::y();
-    z = instance.z() - camera::z();
+    x = proxies.x[proxy] - view.x;
+    y = proxies.y[proxy] - view.y;
+    z = proxies.z[proxy] - view.z;
 
-    if (z == focus()) {
-        instance.set_screen_area(
-            {math::transform_x(x, y, transformation_matrix()),
-             math::transform_y(x, y, transformation_matrix()), instance.width(),
-             instance.height()});
-        return;
+    if (z == view.focus) {
+        z = 1;
+    } else {
+        z = view.focus / z;
+        x *= z;
+        y *= z;
     }
+    transformed_x = x * view.transformation_matrix.at(0);
+    transformed_x += y * view.transformation_matrix.at(1);
+    transformed_y = x * view.transformation_matrix.at(2);
+    transformed_y += y * view.transformation_matrix.at(3);
+    proxies.screen_area[proxy] = {transformed_x, transformed_y,
+                                  proxies.width[proxy] * z,
+                                  proxies.height[proxy] * z};
+}
 
-    z = focus() / z;
-    x *= z;
-    y *= z;
-    instance.set_screen_area({math::transform_x(x, y, transformation_matrix()),
-                              math::transform_y(x, y, transformation_matrix()),
-                              instance.width() * z, instance.height() * z});
+void wze::camera::project(camera_view const& view, render_proxies& proxies,
+                          size_t first, size_t last) {
+#if defined(__x86_64__)
+    if ((bool)SDL_HasAVX2()) {
+        first = project_avx2(view, proxies, first, last);
+    }
+    first = project_sse2(view, proxies, first, last);
+#elif defined(__aarch64__)
+    first = project_neon(view, proxies, first, last);
+#endif
+
+    for (; first != last; ++first) {
+        if ((bool)proxies.drawn[first]) {
+            project(view, proxies, first);
+        }
+    }
 }
 
+#ifdef __clang__
+#pragma float_control(pop)
+#endif /* __clang__ */
+
 std::pair<float, float> wze::camera::project(float x, float y, float z) {
     if (z == camera::z()) {
         return {0, 0};
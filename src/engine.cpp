@@ -22,6 +22,7 @@
 // NOLINTNEXTLINE(bugprone-reserved-identifier,cert-dcl37-c,cert-dcl51-cpp)
 #define __WIZARD_ENGINE_INTERNAL__
 
+#include <wizard_engine/animator.hpp>
 #include <wizard_engine/assets.hpp>
 #include <wizard_engine/audio.hpp>
 #include <wizard_engine/camera.hpp>
@@ -31,10 +32,17 @@
 #include <wizard_engine/math.hpp>
 #include <wizard_engine/renderer.hpp>
 #include <wizard_engine/sprite.hpp>
+#include <wizard_engine/tilemap.hpp>
 #include <wizard_engine/timer.hpp>
 #include <wizard_engine/window.hpp>
 
 std::vector<SDL_Event> wze::engine::_events = {};
+bool wze::engine::_headless = {};
+size_t wze::engine::_frame_limit = {};
+size_t wze::engine::_frames = {};
+std::function<void()> wze::engine::_tick = {};
+float wze::engine::_tick_time = {};
+float wze::engine::_accumulator = {};
 
 void wze::engine::play_intro() {
     // NOLINTNEXTLINE(cppcoreguidelines-avoid-magic-numbers,readability-magic-numbers)
@@ -76,13 +84,69 @@ void wze::engine::play_intro() {
     }
 }
 
+void wze::engine::simulate() {
+    constexpr float max_ticks = 8;
+
+    float delta_time;
+
+    if (!tick() || tick_time() <= 0) {
+        renderer::interpolate(1);
+        return;
+    }
+
+    delta_time = timer::delta_time();
+    _accumulator = std::min(_accumulator + delta_time, max_ticks * tick_time());
+    timer::set_delta_time(tick_time());
+    while (tick_time() <= _accumulator) {
+        renderer::remember();
+        tick()();
+        _accumulator -= tick_time();
+    }
+    timer::set_delta_time(delta_time);
+    renderer::interpolate(_accumulator / tick_time());
+}
+
 std::vector<SDL_Event> const& wze::engine::events() {
     return _events;
 }
 
+bool wze::engine::headless() {
+    return _headless;
+}
+
+size_t wze::engine::frame_limit() {
+    return _frame_limit;
+}
+
+void wze::engine::set_frame_limit(size_t frame_limit) {
+    _frame_limit = frame_limit;
+    _frames = 0;
+}
+
+std::function<void()> const& wze::engine::tick() {
+    return _tick;
+}
+
+void wze::engine::set_tick(std::function<void()> const& tick) {
+    _tick = tick;
+    _accumulator = 0;
+}
+
+float wze::engine::tick_time() {
+    return _tick_time;
+}
+
+void wze::engine::set_tick_time(float tick_time) {
+    _tick_time = tick_time;
+}
+
 void wze::engine::initialize(std::string const& title, uint16_t width,
-                             uint16_t height) {
+                             uint16_t height, bool headless) {
     constexpr uint16_t MIX_DEFAULT_CHUNKSIZE = 4096;
+    constexpr float headless_delta_time = 1000.F / 60;
+    constexpr int32_t decimal = 10;
+
+    char const* frames;
 
     std::set_terminate([]() -> void {
         std::function<void(char const*)> log;
@@ -115,6 +179,14 @@ void wze::engine::initialize(std::string const& title, uint16_t width,
         abort();
     });
 
+    _headless = headless ||
+                (bool)SDL_GetHintBoolean("WZE_HEADLESS", SDL_FALSE);
+    if (engine::headless() &&
+        (!(bool)SDL_SetHint(SDL_HINT_VIDEODRIVER, "dummy") ||
+         !(bool)SDL_SetHint(SDL_HINT_AUDIODRIVER, "dummy") ||
+         !(bool)SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software"))) {
+        throw exception(SDL_GetError());
+    }
 #ifdef __ANDROID__
     if (!(bool)SDL_SetHint(SDL_HINT_ORIENTATIONS, "LandscapeLeft")) {
         throw exception(SDL_GetError());
@@ -144,29 +216,52 @@ void wze::engine::initialize(std::string const& title, uint16_t width,
     }
 
     _events = {};
-    window::initialize(title, width, height);
+    assets::initialize();
+    window::initialize(title, width, height, engine::headless());
     camera::initialize();
-    renderer::initialize();
+    renderer::initialize(engine::headless());
     input::initialize();
-    play_intro();
+    if (engine::headless()) {
+        if (timer::fixed_delta_time() <= 0) {
+            timer::set_fixed_delta_time(headless_delta_time);
+        }
+        frames = SDL_getenv("WZE_HEADLESS_FRAMES");
+        if ((bool)frames) {
+            set_frame_limit(std::strtoull(frames, nullptr, decimal));
+        }
+    } else {
+        play_intro();
+    }
 }
 
 bool wze::engine::update() {
     SDL_Event event;
 
+    animator::update();
     renderer::update();
+    assets::update();
     audio::update();
     timer::update();
 
+    if ((bool)frame_limit() && frame_limit() < ++_frames) {
+        return false;
+    }
+
     _events.clear();
     while ((bool)SDL_PollEvent(&event)) {
         if (event.type == SDL_QUIT) {
             return false;
         }
+        if (event.type == SDL_RENDER_TARGETS_RESET ||
+            event.type == SDL_RENDER_DEVICE_RESET) {
+            renderer::invalidate_plane();
+            tilemap::reset();
+        }
         _events.push_back(event);
     }
 
     input::update();
+    simulate();
 
     return true;
 }
@@ -0,0 +1,116 @@
+/*
+  Wizard Engine
+  Copyright (C) 2023-2024 Zana Domán
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+// NOLINTNEXTLINE(bugprone-reserved-identifier,cert-dcl37-c,cert-dcl51-cpp)
+#define __WIZARD_ENGINE_INTERNAL__
+
+#include <wizard_engine/exception.hpp>
+#include <wizard_engine/glyph_atlas.hpp>
+#include <wizard_engine/renderer.hpp>
+
+wze::glyph const& wze::glyph_atlas::insert(uint32_t codepoint) {
+    std::unique_ptr<image, std::function<void(image*)>> image;
+    int32_t advance;
+    SDL_Rect source;
+
+    image = {TTF_RenderGlyph32_Blended(font().get(), codepoint,
+                                       {std::numeric_limits<uint8_t>::max(),
+                                        std::numeric_limits<uint8_t>::max(),
+                                        std::numeric_limits<uint8_t>::max(),
+                                        std::numeric_limits<uint8_t>::max()}),
+             SDL_FreeSurface};
+    if (!image || (bool)TTF_GlyphMetrics32(font().get(), codepoint, nullptr,
+                                           nullptr, nullptr, nullptr,
+                                           &advance)) {
+        throw exception(TTF_GetError());
+    }
+
+    if (size() < _cursor.x + image->w) {
+        _cursor = {0, _cursor.y + _shelf_height + 1};
+        _shelf_height = 0;
+    }
+    if (size() < _cursor.x + image->w || size() < _cursor.y + image->h) {
+        throw exception("Glyph atlas is full");
+    }
+
+    source = {_cursor.x, _cursor.y, image->w, image->h};
+    if ((bool)SDL_UpdateTexture(texture().get(), &source, image->pixels,
+                                image->pitch)) {
+        throw exception(SDL_GetError());
+    }
+    _cursor.x += image->w + 1;
+    _shelf_height = std::max(_shelf_height, image->h);
+
+    return _glyphs[codepoint] = {source, advance};
+}
+
+std::shared_ptr<wze::font> const& wze::glyph_atlas::font() const {
+    return _font;
+}
+
+std::shared_ptr<wze::texture> const& wze::glyph_atlas::texture() const {
+    return _texture;
+}
+
+uint16_t wze::glyph_atlas::size() const {
+    return _size;
+}
+
+size_t wze::glyph_atlas::glyphs() const {
+    return _glyphs.size();
+}
+
+int32_t wze::glyph_atlas::line_height() const {
+    return TTF_FontLineSkip(font().get());
+}
+
+int32_t wze::glyph_atlas::kerning(uint32_t previous, uint32_t codepoint) const {
+    return TTF_GetFontKerningSizeGlyphs32(font().get(), previous, codepoint);
+}
+
+wze::glyph const& wze::glyph_atlas::lookup(uint32_t codepoint) {
+    std::unordered_map<uint32_t, glyph>::const_iterator iterator;
+
+    iterator = _glyphs.find(codepoint);
+
+    return iterator != _glyphs.end() ? iterator->second : insert(codepoint);
+}
+
+wze::glyph_atlas::glyph_atlas(std::shared_ptr<wze::font> const& font,
+                              uint16_t size) {
+    std::vector<uint32_t> pixels;
+
+    _font = font;
+    _size = size;
+    _cursor = {0, 0};
+    _shelf_height = 0;
+    _texture = {SDL_CreateTexture(renderer::base(), SDL_PIXELFORMAT_ARGB8888,
+                                  SDL_TEXTUREACCESS_STATIC, this->size(),
+                                  this->size()),
+                renderer::release};
+    pixels.resize((size_t)this->size() * this->size());
+    if (!texture() ||
+        (bool)SDL_SetTextureBlendMode(texture().get(), SDL_BLENDMODE_BLEND) ||
+        (bool)SDL_UpdateTexture(texture().get(), nullptr, pixels.data(),
+                                (int32_t)(this->size() * sizeof(uint32_t)))) {
+        throw exception(SDL_GetError());
+    }
+}
@@ -0,0 +1,385 @@
+/*
+  Wizard Engine
+  Copyright (C) 2023-2024 Zana Domán
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+// NOLINTNEXTLINE(bugprone-reserved-identifier,cert-dcl37-c,cert-dcl51-cpp)
+#define __WIZARD_ENGINE_INTERNAL__
+
+#include <wizard_engine/label.hpp>
+#include <wizard_engine/math.hpp>
+
+std::vector<uint32_t> wze::label::decode(std::string const& text) {
+    constexpr uint8_t one_byte = 0x80;
+    constexpr uint8_t two_bytes = 0xE0;
+    constexpr uint8_t three_bytes = 0xF0;
+    constexpr uint8_t lead = 0x7F;
+    constexpr uint8_t continuation = 0x3F;
+    constexpr uint8_t continuation_bits = 6;
+    std::vector<uint32_t> codepoints;
+    size_t index;
+    size_t length;
+    size_t byte;
+    uint32_t codepoint;
+
+    codepoints.reserve(text.size());
+    for (index = 0; index < text.size(); index += length) {
+        codepoint = (uint8_t)text[index];
+        length = codepoint < one_byte      ? 1
+                 : codepoint < two_bytes   ? 2
+                 : codepoint < three_bytes ? 3
+                                           : 4;
+        if (length != 1) {
+            codepoint &= (uint32_t)(lead >> length);
+        }
+        for (byte = 1; byte != length && index + byte < text.size(); ++byte) {
+            codepoint = codepoint << continuation_bits |
+                        ((uint8_t)text[index + byte] & continuation);
+        }
+        codepoints.push_back(codepoint);
+    }
+
+    return codepoints;
+}
+
+void wze::label::build() {
+    std::shared_ptr<std::vector<render_quad>>& quads = proxies().quads[proxy()];
+    std::vector<uint32_t> codepoints;
+    std::vector<std::pair<size_t, float>> lines;
+    std::function<void()> wrap;
+    std::function<float(size_t, size_t)> measure;
+    std::array<float, 4> rotation;
+    size_t first;
+    size_t last;
+    size_t line;
+    uint32_t previous;
+    float pen;
+    float trailing;
+    float width;
+    float height;
+    float offset;
+    float x;
+
+    wrap = [&]() -> void {
+        lines.back().second = pen - trailing;
+        lines.emplace_back(quads->size(), 0);
+        pen = 0;
+        trailing = 0;
+        previous = 0;
+    };
+
+    measure = [&](size_t begin, size_t end) -> float {
+        float length;
+
+        length = (bool)previous
+                     ? (float)atlas()->kerning(previous, codepoints[begin])
+                     : 0;
+        for (; begin != end; ++begin) {
+            length += (float)atlas()->lookup(codepoints[begin]).advance;
+            if (begin + 1 != end) {
+                length += (float)atlas()->kerning(codepoints[begin],
+                                                  codepoints[begin + 1]);
+            }
+        }
+
+        return length;
+    };
+
+    if (!quads || quads.use_count() != 1) {
+        quads = std::make_shared<std::vector<render_quad>>();
+    }
+    quads->clear();
+    lines = {{0, 0}};
+    pen = 0;
+    trailing = 0;
+    previous = 0;
+
+    if (atlas()) {
+        codepoints = decode(text());
+    }
+    for (first = 0; first != codepoints.size(); first = last) {
+        if (codepoints[first] == '\n') {
+            wrap();
+            last = first + 1;
+            continue;
+        }
+
+        last = codepoints[first] == ' '
+                   ? first + 1
+                   : (size_t)(std::find_if(codepoints.begin() +
+                                               (std::ptrdiff_t)first,
+                                           codepoints.end(),
+                                           [](uint32_t codepoint) -> bool {
+                                               return codepoint == ' ' ||
+                                                      codepoint == '\n';
+                                           }) -
+                              codepoints.begin());
+        if ((bool)wrap_length() && (bool)pen &&
+            (float)wrap_length() < pen + measure(first, last)) {
+            wrap();
+            if (codepoints[first] == ' ') {
+                continue;
+            }
+        }
+
+        std::for_each(
+            codepoints.begin() + (std::ptrdiff_t)first,
+            codepoints.begin() + (std::ptrdiff_t)last,
+            [&](uint32_t codepoint) -> void {
+                glyph const& glyph = atlas()->lookup(codepoint);
+                float start;
+
+                start = pen;
+                if ((bool)previous) {
+                    pen += (float)atlas()->kerning(previous, codepoint);
+                }
+                if (codepoint != ' ') {
+                    quads->push_back(
+                        {pen + (float)glyph.source.w / 2,
+                         (float)((lines.size() - 1) * atlas()->line_height()) +
+                             (float)glyph.source.h / 2,
+                         (float)glyph.source.w,
+                         (float)glyph.source.h,
+                         0,
+                         {std::numeric_limits<uint8_t>::max(),
+                          std::numeric_limits<uint8_t>::max(),
+                          std::numeric_limits<uint8_t>::max(),
+                          std::numeric_limits<uint8_t>::max()},
+                         {(float)glyph.source.x / atlas()->size(),
+                          (float)glyph.source.y / atlas()->size(),
+                          (float)glyph.source.w / atlas()->size(),
+                          (float)glyph.source.h / atlas()->size()}});
+                }
+                pen += (float)glyph.advance;
+                trailing = codepoint == ' ' ? trailing + pen - start : 0;
+                previous = codepoint;
+            });
+    }
+    lines.back().second = pen - trailing;
+
+    width = std::max_element(lines.begin(), lines.end(),
+                             [](std::pair<size_t, float> const& line1,
+                                std::pair<size_t, float> const& line2) -> bool {
+                                 return line1.second < line2.second;
+                             })
+                ->second;
+    height = codepoints.empty()
+                 ? 0
+                 : (float)(lines.size() * atlas()->line_height());
+    rotation = math::transformation_matrix(angle(), 1);
+
+    for (line = 0; line != lines.size(); ++line) {
+        offset = (width - lines[line].second) *
+                     (float)(atlas() ? TTF_GetFontWrappedAlign(
+                                           atlas()->font().get())
+                                     : 0) /
+                     2 -
+                 width / 2;
+        std::for_each(
+            quads->begin() + (std::ptrdiff_t)lines[line].first,
+            line + 1 != lines.size()
+                ? quads->begin() + (std::ptrdiff_t)lines[line + 1].first
+                : quads->end(),
+            [&](render_quad& quad) -> void {
+                x = quad.x + offset;
+                quad.x = math::transform_x(x, quad.y - height / 2, rotation);
+                quad.y = math::transform_y(x, quad.y - height / 2, rotation);
+                quad.angle = angle();
+            });
+    }
+
+    proxies().width[proxy()] = width;
+    proxies().height[proxy()] = height;
+    displace();
+    redraw();
+}
+
+float wze::label::x() const {
+    return proxies().x[proxy()];
+}
+
+void wze::label::set_x(float x) {
+    proxies().x[proxy()] = x;
+    displace();
+}
+
+float wze::label::y() const {
+    return proxies().y[proxy()];
+}
+
+void wze::label::set_y(float y) {
+    proxies().y[proxy()] = y;
+    displace();
+}
+
+float wze::label::z() const {
+    return proxies().z[proxy()];
+}
+
+void wze::label::set_z(float z) {
+    proxies().z[proxy()] = z;
+    invalidate();
+}
+
+float wze::label::angle() const {
+    return proxies().angle[proxy()];
+}
+
+void wze::label::set_angle(float angle) {
+    proxies().angle[proxy()] = angle;
+    build();
+}
+
+float wze::label::width() const {
+    return proxies().width[proxy()];
+}
+
+float wze::label::height() const {
+    return proxies().height[proxy()];
+}
+
+bool wze::label::spatial() const {
+    return (bool)proxies().spatial[proxy()];
+}
+
+void wze::label::set_spatial(bool spatial) {
+    proxies().spatial[proxy()] = (uint8_t)spatial;
+    invalidate();
+}
+
+std::shared_ptr<wze::texture> const& wze::label::texture() const {
+    return _texture;
+}
+
+uint8_t wze::label::color_r() const {
+    return proxies().color[proxy()].r;
+}
+
+void wze::label::set_color_r(uint8_t color_r) {
+    proxies().color[proxy()].r = color_r;
+    redraw();
+}
+
+uint8_t wze::label::color_g() const {
+    return proxies().color[proxy()].g;
+}
+
+void wze::label::set_color_g(uint8_t color_g) {
+    proxies().color[proxy()].g = color_g;
+    redraw();
+}
+
+uint8_t wze::label::color_b() const {
+    return proxies().color[proxy()].b;
+}
+
+void wze::label::set_color_b(uint8_t color_b) {
+    proxies().color[proxy()].b = color_b;
+    redraw();
+}
+
+uint8_t wze::label::color_a() const {
+    return proxies().color[proxy()].a;
+}
+
+void wze::label::set_color_a(uint8_t color_a) {
+    proxies().color[proxy()].a = color_a;
+    redraw();
+}
+
+wze::flip wze::label::flip() const {
+    return (enum flip)proxies().flip[proxy()];
+}
+
+void wze::label::set_flip(enum flip flip) {
+    proxies().flip[proxy()] = flip;
+    redraw();
+}
+
+bool wze::label::visible() const {
+    return (bool)proxies().visible[proxy()];
+}
+
+void wze::label::set_visible(bool visible) {
+    proxies().visible[proxy()] = (uint8_t)visible;
+    invalidate();
+}
+
+uint8_t wze::label::priority() const {
+    return proxies().priority[proxy()];
+}
+
+void wze::label::set_priority(uint8_t priority) {
+    proxies().priority[proxy()] = priority;
+    invalidate();
+}
+
+std::shared_ptr<wze::glyph_atlas> const& wze::label::atlas() const {
+    return _atlas;
+}
+
+void wze::label::set_atlas(std::shared_ptr<glyph_atlas> const& atlas) {
+    _atlas = atlas;
+    _texture = atlas ? atlas->texture() : nullptr;
+    proxies().texture[proxy()] = _texture.get();
+    build();
+}
+
+std::string const& wze::label::text() const {
+    return _text;
+}
+
+void wze::label::set_text(std::string const& text) {
+    if (this->text() != text) {
+        _text = text;
+        build();
+    }
+}
+
+uint32_t wze::label::wrap_length() const {
+    return _wrap_length;
+}
+
+void wze::label::set_wrap_length(uint32_t wrap_length) {
+    _wrap_length = wrap_length;
+    build();
+}
+
+wze::label::label(float x, float y, float z, float angle, bool spatial,
+                  std::shared_ptr<glyph_atlas> const& atlas,
+                  std::string const& text, uint32_t wrap_length,
+                  uint8_t color_r, uint8_t color_g, uint8_t color_b,
+                  uint8_t color_a, bool visible, uint8_t priority)
+    : renderable(false) {
+    set_x(x);
+    set_y(y);
+    set_z(z);
+    proxies().angle[proxy()] = angle;
+    set_spatial(spatial);
+    set_color_r(color_r);
+    set_color_g(color_g);
+    set_color_b(color_b);
+    set_color_a(color_a);
+    set_flip(FLIP_NONE);
+    set_visible(visible);
+    set_priority(priority);
+    _text = text;
+    _wrap_length = wrap_length;
+    set_atlas(atlas);
+}
@@ -0,0 +1,167 @@
+/*
+  Wizard Engine
+  Copyright (C) 2023-2024 Zana Domán
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+// NOLINTNEXTLINE(bugprone-reserved-identifier,cert-dcl37-c,cert-dcl51-cpp)
+#define __WIZARD_ENGINE_INTERNAL__
+
+#include <wizard_engine/exception.hpp>
+#include <wizard_engine/pack.hpp>
+
+#if defined(__linux__) && !defined(__ANDROID__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif /* __linux__ && !__ANDROID__ */
+
+wze::pack::entry wze::pack::read(uint64_t index) const {
+    entry entry;
+
+    std::memcpy(&entry,
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                _data.get() + sizeof(_magic) + sizeof(_count) +
+                    index * sizeof(entry),
+                sizeof(entry));
+
+    return entry;
+}
+
+uint64_t wze::pack::hash(std::string const& path) {
+    constexpr uint64_t offset_basis = 14695981039346656037U;
+    constexpr uint64_t prime = 1099511628211U;
+
+    uint64_t hash;
+
+    hash = offset_basis;
+    std::for_each(path.begin(), path.end(), [&](char character) -> void {
+        hash = (hash ^ (uint8_t)character) * prime;
+    });
+
+    return hash;
+}
+
+std::string wze::pack::normalize(std::string const& path) {
+    return std::filesystem::path(path).lexically_normal().generic_string();
+}
+
+bool wze::pack::contains(std::string const& path) const {
+    return (bool)view(path).first;
+}
+
+std::pair<uint8_t const*, size_t>
+wze::pack::view(std::string const& path) const {
+    std::string key;
+    uint64_t target;
+    uint64_t first;
+    uint64_t last;
+    uint64_t middle;
+    entry current;
+
+    key = normalize(path);
+    target = hash(key);
+    first = 0;
+    last = _count;
+    while (first != last) {
+        middle = first + (last - first) / 2;
+        if (read(middle).hash < target) {
+            first = middle + 1;
+        } else {
+            last = middle;
+        }
+    }
+
+    for (; first != _count && (current = read(first)).hash == target;
+         ++first) {
+        if (current.path_size == key.size() &&
+            current.path_offset <= _size &&
+            current.path_size <= _size - current.path_offset &&
+            current.offset <= _size && current.size <= _size - current.offset &&
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            std::memcmp(_data.get() + current.path_offset, key.data(),
+                        key.size()) == 0) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            return {_data.get() + current.offset, (size_t)current.size};
+        }
+    }
+
+    return {nullptr, 0};
+}
+
+SDL_RWops* wze::pack::open(std::string const& path) const {
+    std::pair<uint8_t const*, size_t> contents;
+
+    contents = view(path);
+
+    return (bool)contents.first
+               ? SDL_RWFromConstMem(contents.first, (int32_t)contents.second)
+               : nullptr;
+}
+
+wze::pack::pack(std::string const& path) {
+    std::array<char, sizeof(_magic)> magic;
+
+#if defined(__linux__) && !defined(__ANDROID__)
+    int32_t file;
+    struct stat status;
+    void* data;
+
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg,hicpp-vararg)
+    file = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (file == -1 || fstat(file, &status) == -1) {
+        if (file != -1) {
+            close(file);
+        }
+        throw exception("Cannot open pack " + path);
+    }
+    _size = (size_t)status.st_size;
+    data = (bool)_size
+               ? mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, file, 0)
+               : MAP_FAILED;
+    close(file);
+    if (data == MAP_FAILED) {
+        throw exception("Cannot map pack " + path);
+    }
+    _data = {static_cast<uint8_t const*>(data),
+             [size = _size](uint8_t const* data) -> void {
+                 munmap(const_cast<uint8_t*>(data), size);
+             }};
+#else  /* __linux__ && !__ANDROID__ */
+    _data = {static_cast<uint8_t const*>(SDL_LoadFile(path.c_str(), &_size)),
+             [](uint8_t const* data) -> void {
+                 SDL_free(const_cast<uint8_t*>(data));
+             }};
+    if (!_data) {
+        throw exception(SDL_GetError());
+    }
+#endif /* __linux__ && !__ANDROID__ */
+
+    if (_size < sizeof(magic) + sizeof(_count)) {
+        throw exception("Malformed pack " + path);
+    }
+    std::memcpy(magic.data(), _data.get(), sizeof(magic));
+    std::memcpy(&_count,
+                // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                _data.get() + sizeof(magic), sizeof(_count));
+    if (magic != _magic ||
+        (_size - sizeof(magic) - sizeof(_count)) / sizeof(entry) < _count) {
+        throw exception("Malformed pack " + path);
+    }
+}
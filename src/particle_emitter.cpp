@@ -0,0 +1,417 @@
+/*
+  Wizard Engine
+  Copyright (C) 2023-2024 Zana Domán
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+// NOLINTNEXTLINE(bugprone-reserved-identifier,cert-dcl37-c,cert-dcl51-cpp)
+#define __WIZARD_ENGINE_INTERNAL__
+
+#include <wizard_engine/math.hpp>
+#include <wizard_engine/particle_emitter.hpp>
+#include <wizard_engine/timer.hpp>
+
+void wze::particle_emitter::expire(size_t count) {
+    std::function<void(std::vector<float>&)> erase;
+
+    _head += count;
+    if (_age.size() - _head < _head) {
+        erase = [&](std::vector<float>& values) -> void {
+            values.erase(values.begin(),
+                         values.begin() + (std::ptrdiff_t)_head);
+        };
+
+        erase(_particle_x);
+        erase(_particle_y);
+        erase(_velocity_x);
+        erase(_velocity_y);
+        erase(_age);
+        _head = 0;
+    }
+}
+
+void wze::particle_emitter::emit(size_t count) {
+    float direction;
+
+    for (; (bool)count; --count) {
+        direction = angle() + math::random(-spread() / 2, spread() / 2);
+        _particle_x.push_back(x());
+        _particle_y.push_back(y());
+        _velocity_x.push_back(math::move_x(speed(), direction));
+        _velocity_y.push_back(math::move_y(speed(), direction));
+        _age.push_back(0);
+    }
+}
+
+static inline uint8_t fade(uint8_t start, uint8_t end, float progress) {
+    return (uint8_t)((float)start + ((float)end - (float)start) * progress);
+}
+
+void wze::particle_emitter::build() {
+    std::shared_ptr<std::vector<render_quad>>& quads = proxies().quads[proxy()];
+    size_t particle;
+    float extent;
+
+    if (!quads || quads.use_count() != 1) {
+        quads = std::make_shared<std::vector<render_quad>>();
+    }
+    quads->resize(particles());
+    _progress.resize(particles());
+    _size.resize(particles());
+
+    std::transform(_age.begin() + (std::ptrdiff_t)_head, _age.end(),
+                   _progress.begin(), [&](float age) -> float {
+                       return age / lifetime();
+                   });
+    std::transform(_progress.begin(), _progress.end(), _size.begin(),
+                   [&](float progress) -> float {
+                       return start_size() +
+                              (end_size() - start_size()) * progress;
+                   });
+
+    extent = 0;
+    for (particle = 0; particle != particles(); ++particle) {
+        (*quads)[particle] = {
+            _particle_x[_head + particle] - x(),
+            _particle_y[_head + particle] - y(),
+            _size[particle],
+            _size[particle],
+            0,
+            {fade(start_color().r, end_color().r, _progress[particle]),
+             fade(start_color().g, end_color().g, _progress[particle]),
+             fade(start_color().b, end_color().b, _progress[particle]),
+             fade(start_color().a, end_color().a, _progress[particle])},
+            {0, 0, 1, 1}};
+        extent = std::max(
+            {extent, fabsf((*quads)[particle].x) + _size[particle] / 2,
+             fabsf((*quads)[particle].y) + _size[particle] / 2});
+    }
+
+    proxies().width[proxy()] = proxies().height[proxy()] = 2 * extent;
+    displace();
+    redraw();
+}
+
+float wze::particle_emitter::x() const {
+    return proxies().x[proxy()];
+}
+
+void wze::particle_emitter::set_x(float x) {
+    proxies().x[proxy()] = x;
+    displace();
+}
+
+float wze::particle_emitter::y() const {
+    return proxies().y[proxy()];
+}
+
+void wze::particle_emitter::set_y(float y) {
+    proxies().y[proxy()] = y;
+    displace();
+}
+
+float wze::particle_emitter::z() const {
+    return proxies().z[proxy()];
+}
+
+void wze::particle_emitter::set_z(float z) {
+    proxies().z[proxy()] = z;
+    invalidate();
+}
+
+float wze::particle_emitter::angle() const {
+    return proxies().angle[proxy()];
+}
+
+void wze::particle_emitter::set_angle(float angle) {
+    proxies().angle[proxy()] = angle;
+    redraw();
+}
+
+float wze::particle_emitter::width() const {
+    return proxies().width[proxy()];
+}
+
+float wze::particle_emitter::height() const {
+    return proxies().height[proxy()];
+}
+
+bool wze::particle_emitter::spatial() const {
+    return (bool)proxies().spatial[proxy()];
+}
+
+void wze::particle_emitter::set_spatial(bool spatial) {
+    proxies().spatial[proxy()] = (uint8_t)spatial;
+    invalidate();
+}
+
+std::shared_ptr<wze::texture> const& wze::particle_emitter::texture() const {
+    return _texture;
+}
+
+void wze::particle_emitter::set_texture(
+    std::shared_ptr<wze::texture> const& texture) {
+    _texture = texture;
+    proxies().texture[proxy()] = texture.get();
+    redraw();
+}
+
+uint8_t wze::particle_emitter::color_r() const {
+    return proxies().color[proxy()].r;
+}
+
+void wze::particle_emitter::set_color_r(uint8_t color_r) {
+    proxies().color[proxy()].r = color_r;
+    redraw();
+}
+
+uint8_t wze::particle_emitter::color_g() const {
+    return proxies().color[proxy()].g;
+}
+
+void wze::particle_emitter::set_color_g(uint8_t color_g) {
+    proxies().color[proxy()].g = color_g;
+    redraw();
+}
+
+uint8_t wze::particle_emitter::color_b() const {
+    return proxies().color[proxy()].b;
+}
+
+void wze::particle_emitter::set_color_b(uint8_t color_b) {
+    proxies().color[proxy()].b = color_b;
+    redraw();
+}
+
+uint8_t wze::particle_emitter::color_a() const {
+    return proxies().color[proxy()].a;
+}
+
+void wze::particle_emitter::set_color_a(uint8_t color_a) {
+    proxies().color[proxy()].a = color_a;
+    redraw();
+}
+
+wze::flip wze::particle_emitter::flip() const {
+    return (enum flip)proxies().flip[proxy()];
+}
+
+void wze::particle_emitter::set_flip(enum flip flip) {
+    proxies().flip[proxy()] = flip;
+    redraw();
+}
+
+bool wze::particle_emitter::visible() const {
+    return (bool)proxies().visible[proxy()];
+}
+
+void wze::particle_emitter::set_visible(bool visible) {
+    proxies().visible[proxy()] = (uint8_t)visible;
+    invalidate();
+}
+
+uint8_t wze::particle_emitter::priority() const {
+    return proxies().priority[proxy()];
+}
+
+void wze::particle_emitter::set_priority(uint8_t priority) {
+    proxies().priority[proxy()] = priority;
+    invalidate();
+}
+
+size_t wze::particle_emitter::capacity() const {
+    return _capacity;
+}
+
+void wze::particle_emitter::set_capacity(size_t capacity) {
+    _capacity = capacity;
+    if (this->capacity() < particles()) {
+        expire(particles() - this->capacity());
+    }
+}
+
+float wze::particle_emitter::rate() const {
+    return _rate;
+}
+
+void wze::particle_emitter::set_rate(float rate) {
+    _rate = rate;
+}
+
+float wze::particle_emitter::lifetime() const {
+    return _lifetime;
+}
+
+void wze::particle_emitter::set_lifetime(float lifetime) {
+    _lifetime = lifetime;
+}
+
+float wze::particle_emitter::speed() const {
+    return _speed;
+}
+
+void wze::particle_emitter::set_speed(float speed) {
+    _speed = speed;
+}
+
+float wze::particle_emitter::spread() const {
+    return _spread;
+}
+
+void wze::particle_emitter::set_spread(float spread) {
+    _spread = spread;
+}
+
+float wze::particle_emitter::acceleration_x() const {
+    return _acceleration_x;
+}
+
+void wze::particle_emitter::set_acceleration_x(float acceleration_x) {
+    _acceleration_x = acceleration_x;
+}
+
+float wze::particle_emitter::acceleration_y() const {
+    return _acceleration_y;
+}
+
+void wze::particle_emitter::set_acceleration_y(float acceleration_y) {
+    _acceleration_y = acceleration_y;
+}
+
+float wze::particle_emitter::start_size() const {
+    return _start_size;
+}
+
+void wze::particle_emitter::set_start_size(float start_size) {
+    _start_size = start_size;
+}
+
+float wze::particle_emitter::end_size() const {
+    return _end_size;
+}
+
+void wze::particle_emitter::set_end_size(float end_size) {
+    _end_size = end_size;
+}
+
+SDL_Color const& wze::particle_emitter::start_color() const {
+    return _start_color;
+}
+
+void wze::particle_emitter::set_start_color(SDL_Color const& start_color) {
+    _start_color = start_color;
+}
+
+SDL_Color const& wze::particle_emitter::end_color() const {
+    return _end_color;
+}
+
+void wze::particle_emitter::set_end_color(SDL_Color const& end_color) {
+    _end_color = end_color;
+}
+
+size_t wze::particle_emitter::particles() const {
+    return _age.size() - _head;
+}
+
+void wze::particle_emitter::update() {
+    float delta_time;
+    std::ptrdiff_t head;
+    size_t count;
+
+    delta_time = timer::delta_time();
+    head = (std::ptrdiff_t)_head;
+
+    std::transform(_velocity_x.begin() + head, _velocity_x.end(),
+                   _velocity_x.begin() + head, [&](float velocity_x) -> float {
+                       return velocity_x + acceleration_x() * delta_time;
+                   });
+    std::transform(_velocity_y.begin() + head, _velocity_y.end(),
+                   _velocity_y.begin() + head, [&](float velocity_y) -> float {
+                       return velocity_y + acceleration_y() * delta_time;
+                   });
+    std::transform(_particle_x.begin() + head, _particle_x.end(),
+                   _velocity_x.begin() + head, _particle_x.begin() + head,
+                   [&](float particle_x, float velocity_x) -> float {
+                       return particle_x + velocity_x * delta_time;
+                   });
+    std::transform(_particle_y.begin() + head, _particle_y.end(),
+                   _velocity_y.begin() + head, _particle_y.begin() + head,
+                   [&](float particle_y, float velocity_y) -> float {
+                       return particle_y + velocity_y * delta_time;
+                   });
+    std::transform(_age.begin() + head, _age.end(), _age.begin() + head,
+                   [&](float age) -> float {
+                       return age + delta_time;
+                   });
+
+    expire((size_t)(std::partition_point(_age.begin() + head, _age.end(),
+                                         [&](float age) -> bool {
+                                             return lifetime() <= age;
+                                         }) -
+                    (_age.begin() + head)));
+
+    _emission += rate() * delta_time / 1000;
+    count = (size_t)_emission;
+    _emission -= (float)count;
+    emit(std::min(count, capacity() - particles()));
+
+    build();
+}
+
+void wze::particle_emitter::clear() {
+    expire(particles());
+    _emission = 0;
+    build();
+}
+
+wze::particle_emitter::particle_emitter(
+    float x, float y, float z, float angle, bool spatial,
+    std::shared_ptr<wze::texture> const& texture, size_t capacity, float rate,
+    float lifetime, float speed, float spread, float start_size,
+    float end_size, SDL_Color const& start_color, SDL_Color const& end_color,
+    bool visible, uint8_t priority)
+    : renderable(false) {
+    _head = 0;
+    set_x(x);
+    set_y(y);
+    set_z(z);
+    set_angle(angle);
+    set_spatial(spatial);
+    set_texture(texture);
+    set_color_r(std::numeric_limits<uint8_t>::max());
+    set_color_g(std::numeric_limits<uint8_t>::max());
+    set_color_b(std::numeric_limits<uint8_t>::max());
+    set_color_a(std::numeric_limits<uint8_t>::max());
+    set_flip(FLIP_NONE);
+    set_visible(visible);
+    set_priority(priority);
+    set_capacity(capacity);
+    set_rate(rate);
+    set_lifetime(lifetime);
+    set_speed(speed);
+    set_spread(spread);
+    set_acceleration_x(0);
+    set_acceleration_y(0);
+    set_start_size(start_size);
+    set_end_size(end_size);
+    set_start_color(start_color);
+    set_end_color(end_color);
+    _emission = 0;
+    build();
+}
@@ -23,48 +23,278 @@
 #define __WIZARD_ENGINE_INTERNAL__
 
 #include <wizard_engine/renderable.hpp>
+#include <wizard_engine/renderer.hpp>
 
-std::vector<wze::renderable*> wze::renderable::_instances = {};
+wze::render_proxies wze::renderable::_proxies = {};
+std::vector<size_t> wze::renderable::_released = {};
+std::vector<size_t> wze::renderable::_retired = {};
+std::vector<size_t> wze::renderable::_invalidated = {};
+std::vector<size_t> wze::renderable::_displaced = {};
+size_t wze::renderable::_serials = {};
+size_t wze::renderable::_polled = {};
 
-std::vector<wze::renderable*> const& wze::renderable::instances() {
-    return _instances;
+size_t wze::renderable::acquire() {
+    size_t proxy;
+
+    if (_released.empty()) {
+        proxy = _proxies.owner.size();
+        _proxies.owner.emplace_back();
+        _proxies.serial.emplace_back();
+        _proxies.x.emplace_back();
+        _proxies.y.emplace_back();
+        _proxies.z.emplace_back();
+        _proxies.angle.emplace_back();
+        _proxies.width.emplace_back();
+        _proxies.height.emplace_back();
+        _proxies.spatial.emplace_back();
+        _proxies.texture.emplace_back();
+        _proxies.source.emplace_back();
+        _proxies.color.emplace_back();
+        _proxies.flip.emplace_back();
+        _proxies.visible.emplace_back();
+        _proxies.priority.emplace_back();
+        _proxies.polled.emplace_back();
+        _proxies.invalid.emplace_back();
+        _proxies.displaced.emplace_back();
+        _proxies.queued.emplace_back();
+        _proxies.cell.emplace_back();
+        _proxies.frame.emplace_back();
+        _proxies.drawn.emplace_back();
+        _proxies.screen_area.emplace_back();
+        _proxies.screen_angle.emplace_back();
+        _proxies.quads.emplace_back();
+    } else {
+        proxy = _released.back();
+        _released.pop_back();
+    }
+
+    _proxies.serial[proxy] = _serials++;
+    _proxies.invalid[proxy] = (uint8_t)false;
+    _proxies.displaced[proxy] = (uint8_t)false;
+    _proxies.queued[proxy] = std::numeric_limits<uint64_t>::max();
+    _proxies.cell[proxy] = std::numeric_limits<uint64_t>::max();
+    _proxies.frame[proxy] = 0;
+    _proxies.drawn[proxy] = (uint8_t)false;
+
+    return proxy;
+}
+
+void wze::renderable::release(size_t proxy) {
+    if ((bool)_proxies.polled[proxy]) {
+        _proxies.polled[proxy] = (uint8_t)false;
+        --_polled;
+    }
+    _proxies.owner[proxy] = nullptr;
+    _proxies.visible[proxy] = (uint8_t)false;
+    _proxies.texture[proxy] = nullptr;
+    _proxies.quads[proxy] = {};
+    _retired.push_back(proxy);
+}
+
+void wze::renderable::refresh() {
+    bool invalid;
+    bool displaced;
+    bool redrawn;
+    SDL_Color color;
+
+    color = {color_r(), color_g(), color_b(), color_a()};
+    invalid = _proxies.z[proxy()] != z() ||
+              (bool)_proxies.spatial[proxy()] != spatial() ||
+              (bool)_proxies.visible[proxy()] != visible() ||
+              _proxies.priority[proxy()] != priority();
+    displaced = _proxies.x[proxy()] != x() || _proxies.y[proxy()] != y() ||
+                _proxies.width[proxy()] != width() ||
+                _proxies.height[proxy()] != height();
+    redrawn = _proxies.angle[proxy()] != angle() ||
+              _proxies.texture[proxy()] != texture().get() ||
+              _proxies.color[proxy()].r != color.r ||
+              _proxies.color[proxy()].g != color.g ||
+              _proxies.color[proxy()].b != color.b ||
+              _proxies.color[proxy()].a != color.a ||
+              _proxies.flip[proxy()] != flip();
+    if (!invalid && !displaced && !redrawn) {
+        return;
+    }
+
+    _proxies.x[proxy()] = x();
+    _proxies.y[proxy()] = y();
+    _proxies.z[proxy()] = z();
+    _proxies.angle[proxy()] = angle();
+    _proxies.width[proxy()] = width();
+    _proxies.height[proxy()] = height();
+    _proxies.spatial[proxy()] = (uint8_t)spatial();
+    _proxies.texture[proxy()] = texture().get();
+    _proxies.color[proxy()] = color;
+    _proxies.flip[proxy()] = flip();
+    _proxies.visible[proxy()] = (uint8_t)visible();
+    _proxies.priority[proxy()] = priority();
+    if (invalid) {
+        invalidate();
+    } else if (displaced) {
+        displace();
+    }
+    if (redrawn) {
+        redraw();
+    }
+}
+
+void wze::renderable::invalidate() {
+    displace();
+    if (!(bool)_proxies.invalid[proxy()]) {
+        _proxies.invalid[proxy()] = (uint8_t)true;
+        _invalidated.push_back(proxy());
+    }
+}
+
+void wze::renderable::displace() {
+    if (!(bool)_proxies.displaced[proxy()]) {
+        _proxies.displaced[proxy()] = (uint8_t)true;
+        _displaced.push_back(proxy());
+    }
+}
+
+void wze::renderable::redraw() {
+    if (!(bool)_proxies.spatial[proxy()] && (bool)_proxies.visible[proxy()]) {
+        renderer::invalidate_plane();
+    }
+}
+
+void wze::renderable::synchronize() {
+    _proxies.x[proxy()] = x();
+    _proxies.y[proxy()] = y();
+    _proxies.z[proxy()] = z();
+    _proxies.angle[proxy()] = angle();
+    _proxies.width[proxy()] = width();
+    _proxies.height[proxy()] = height();
+    _proxies.spatial[proxy()] = (uint8_t)spatial();
+    _proxies.texture[proxy()] = texture().get();
+    _proxies.color[proxy()] = {color_r(), color_g(), color_b(), color_a()};
+    _proxies.flip[proxy()] = flip();
+    _proxies.visible[proxy()] = (uint8_t)visible();
+    _proxies.priority[proxy()] = priority();
+    invalidate();
+}
+
+wze::render_proxies& wze::renderable::proxies() {
+    return _proxies;
+}
+
+std::vector<size_t> const& wze::renderable::invalidated() {
+    return _invalidated;
+}
+
+std::vector<size_t> const& wze::renderable::displaced() {
+    return _displaced;
+}
+
+void wze::renderable::poll() {
+    size_t proxy;
+
+    if (!(bool)_polled) {
+        return;
+    }
+
+    for (proxy = 0; proxy != _proxies.owner.size(); ++proxy) {
+        if ((bool)_proxies.polled[proxy]) {
+            _proxies.owner[proxy]->refresh();
+        }
+    }
+}
+
+void wze::renderable::validate() {
+    std::for_each(displaced().begin(), displaced().end(),
+                  [](size_t proxy) -> void {
+                      _proxies.invalid[proxy] = (uint8_t)false;
+                      _proxies.displaced[proxy] = (uint8_t)false;
+                  });
+    _invalidated.clear();
+    _displaced.clear();
+    _released.insert(_released.end(), _retired.begin(), _retired.end());
+    _retired.clear();
+}
+
+size_t wze::renderable::proxy() const {
+    return _proxy;
 }
 
 SDL_FRect const& wze::renderable::screen_area() const {
-    return _screen_area;
+    return _proxies.screen_area[proxy()];
+}
+
+SDL_FRect const& wze::renderable::source() const {
+    return _proxies.source[proxy()];
 }
 
 void wze::renderable::set_screen_area(SDL_FRect const& screen_area) {
-    _screen_area = screen_area;
+    _proxies.screen_area[proxy()] = screen_area;
 }
 
 float wze::renderable::screen_angle() const {
-    return _screen_angle;
+    return _proxies.screen_angle[proxy()];
 }
 
 void wze::renderable::set_screen_angle(float screen_angle) {
-    _screen_angle = screen_angle;
+    _proxies.screen_angle[proxy()] = screen_angle;
 }
 
-wze::renderable::renderable() {
+wze::renderable::renderable() : renderable(true) {}
+
+wze::renderable::renderable(bool polled) {
+    _proxy = acquire();
+    _proxies.polled[proxy()] = (uint8_t)polled;
+    _polled += (size_t)polled;
+    _proxies.owner[proxy()] = this;
+    _proxies.x[proxy()] = 0;
+    _proxies.y[proxy()] = 0;
+    _proxies.z[proxy()] = 0;
+    _proxies.angle[proxy()] = 0;
+    _proxies.width[proxy()] = 0;
+    _proxies.height[proxy()] = 0;
+    _proxies.spatial[proxy()] = (uint8_t)false;
+    _proxies.texture[proxy()] = nullptr;
+    _proxies.source[proxy()] = {0, 0, 1, 1};
+    _proxies.color[proxy()] = {0, 0, 0, 0};
+    _proxies.flip[proxy()] = FLIP_NONE;
+    _proxies.visible[proxy()] = (uint8_t)false;
+    _proxies.priority[proxy()] = 0;
+    _proxies.quads[proxy()] = {};
     set_screen_area({0, 0, 0, 0});
     set_screen_angle(0);
-    _instances.push_back(this);
+    invalidate();
 }
 
 wze::renderable::renderable(renderable const& other) {
+    _proxy = acquire();
+    _proxies.owner[proxy()] = this;
+    _proxies.polled[proxy()] = _proxies.polled[other.proxy()];
+    _polled += (size_t)_proxies.polled[proxy()];
     *this = other;
-    _instances.push_back(this);
 }
 
 wze::renderable::~renderable() {
-    _instances.erase(std::find(instances().begin(), instances().end(), this));
+    invalidate();
+    release(proxy());
 }
 
 wze::renderable& wze::renderable::operator=(renderable const& other) {
     if (&other != this) {
+        _proxies.x[proxy()] = _proxies.x[other.proxy()];
+        _proxies.y[proxy()] = _proxies.y[other.proxy()];
+        _proxies.z[proxy()] = _proxies.z[other.proxy()];
+        _proxies.angle[proxy()] = _proxies.angle[other.proxy()];
+        _proxies.width[proxy()] = _proxies.width[other.proxy()];
+        _proxies.height[proxy()] = _proxies.height[other.proxy()];
+        _proxies.spatial[proxy()] = _proxies.spatial[other.proxy()];
+        _proxies.texture[proxy()] = _proxies.texture[other.proxy()];
+        _proxies.source[proxy()] = _proxies.source[other.proxy()];
+        _proxies.color[proxy()] = _proxies.color[other.proxy()];
+        _proxies.flip[proxy()] = _proxies.flip[other.proxy()];
+        _proxies.visible[proxy()] = _proxies.visible[other.proxy()];
+        _proxies.priority[proxy()] = _proxies.priority[other.proxy()];
+        _proxies.quads[proxy()] = _proxies.quads[other.proxy()];
         set_screen_area(other.screen_area());
         set_screen_angle(other.screen_angle());
+        invalidate();
     }
 
     return *this;
@@ -43,109 +43,965 @@ uint8_t wze::renderer::_space_color_b = {};
 uint8_t wze::renderer::_space_color_a = {};
 std::shared_ptr<wze::texture> wze::renderer::_space_texture = {};
 SDL_FRect wze::renderer::_space_area = {};
+float wze::renderer::_resolution_scale = {};
+float wze::renderer::_resolution_budget = {};
+float wze::renderer::_submit_time = {};
 std::unique_ptr<wze::texture, std::function<void(wze::texture*)>>
     wze::renderer::_plane = {};
 uint8_t wze::renderer::_plane_color_r = {};
 uint8_t wze::renderer::_plane_color_g = {};
 uint8_t wze::renderer::_plane_color_b = {};
 uint8_t wze::renderer::_plane_color_a = {};
+bool wze::renderer::_plane_retained = {};
+bool wze::renderer::_plane_invalid = {};
+size_t wze::renderer::_plane_reuses = {};
+size_t wze::renderer::_plane_redraws = {};
+wze::renderer::pass wze::renderer::_space_pass = {};
+wze::renderer::pass wze::renderer::_plane_pass = {};
+std::vector<int32_t> wze::renderer::_indices = {};
+std::vector<wze::renderer::entry> wze::renderer::_space_queue = {};
+std::vector<wze::renderer::entry> wze::renderer::_plane_queue = {};
+std::unordered_map<uint64_t, wze::renderer::cell> wze::renderer::_grid = {};
+size_t wze::renderer::_frame = {};
+std::array<wze::renderer::frame, 2> wze::renderer::_frames = {};
+size_t wze::renderer::_current = {};
+bool wze::renderer::_pending = {};
+bool wze::renderer::_pipelined = {};
+size_t wze::renderer::_workers = {};
+SDL_sem* wze::renderer::_start = {};
+SDL_sem* wze::renderer::_phase = {};
+SDL_sem* wze::renderer::_done = {};
+SDL_atomic_t wze::renderer::_arrived = {};
+std::vector<wze::texture*> wze::renderer::_released = {};
+std::unordered_map<wze::texture*, SDL_Color> wze::renderer::_modulations = {};
+wze::render_stats wze::renderer::_stats = {};
+bool wze::renderer::_readback = {};
+std::shared_ptr<wze::image> wze::renderer::_screenshot = {};
+wze::renderer::pose wze::renderer::_previous = {};
+float wze::renderer::_interpolation = 1;
+
+uint64_t wze::renderer::key(float z, uint8_t priority) {
+    constexpr uint32_t sign = (uint32_t)1 << 31;
+
+    uint32_t bits;
+
+    std::memcpy(&bits, &z, sizeof(bits));
+    if (bits == sign) {
+        bits = 0;
+    }
+    bits = (bool)(bits & sign) ? ~bits : bits | sign;
+
+    return (uint64_t)~bits << std::numeric_limits<uint8_t>::digits | priority;
+}
+
+uint8_t wze::renderer::digit(entry const& entry, size_t position) {
+    constexpr size_t bits = std::numeric_limits<uint8_t>::digits;
+
+    return (uint8_t)(position < sizeof(entry.serial)
+                         ? entry.serial >> (position * bits)
+                         : entry.key >> ((position - sizeof(entry.serial)) *
+                                         bits));
+}
+
+void wze::renderer::radix(std::vector<entry>& entries) {
+    constexpr size_t positions =
+        sizeof(entry::serial) + sizeof(uint32_t) + sizeof(uint8_t);
+    constexpr size_t buckets = (size_t)std::numeric_limits<uint8_t>::max() + 1;
+
+    std::array<std::array<size_t, buckets>, positions> counts;
+    std::vector<entry> sorted;
+    size_t position;
+    size_t offset;
+
+    if (entries.size() < 2) {
+        return;
+    }
+
+    counts = {};
+    std::for_each(entries.begin(), entries.end(),
+                  [&](entry const& entry) -> void {
+                      for (position = 0; position != positions; ++position) {
+                          ++counts.at(position).at(digit(entry, position));
+                      }
+                  });
+
+    sorted.resize(entries.size());
+    for (position = 0; position != positions; ++position) {
+        if (counts.at(position).at(digit(entries.front(), position)) ==
+            entries.size()) {
+            continue;
+        }
+
+        offset = 0;
+        std::for_each(counts.at(position).begin(), counts.at(position).end(),
+                      [&](size_t& count) -> void {
+                          std::swap(count, offset);
+                          offset += count;
+                      });
+        std::for_each(entries.begin(), entries.end(),
+                      [&](entry const& entry) -> void {
+                          sorted[counts.at(position).at(
+                              digit(entry, position))++] = entry;
+                      });
+        entries.swap(sorted);
+    }
+}
+
+bool wze::renderer::precedes(entry const& entry1, entry const& entry2) {
+    if (entry1.key != entry2.key) {
+        return entry1.key < entry2.key;
+    }
+    return entry1.serial < entry2.serial;
+}
+
+void wze::renderer::requeue() {
+    render_proxies& proxies = renderable::proxies();
+    std::vector<entry> space;
+    std::vector<entry> plane;
+    std::function<bool(std::vector<entry>&, size_t&, size_t)> erase;
+    std::function<void(std::vector<entry>&, size_t, std::vector<entry>&)>
+        merge;
+    size_t space_first;
+    size_t plane_first;
+    bool changed;
+
+    if (renderable::invalidated().empty()) {
+        return;
+    }
+
+    erase = [&](std::vector<entry>& queue, size_t& first,
+                size_t proxy) -> bool {
+        std::vector<entry>::iterator iterator;
+
+        iterator = std::lower_bound(
+            queue.begin(), queue.end(),
+            entry{proxies.queued[proxy], proxies.serial[proxy], proxy},
+            precedes);
+        if (iterator == queue.end() || iterator->proxy != proxy) {
+            return false;
+        }
+
+        iterator->proxy = _no_proxy;
+        first = std::min(first, (size_t)(iterator - queue.begin()));
+        return true;
+    };
+
+    merge = [&](std::vector<entry>& queue, size_t first,
+                std::vector<entry>& entries) -> void {
+        size_t middle;
+
+        queue.erase(std::remove_if(queue.begin() + (std::ptrdiff_t)first,
+                                   queue.end(),
+                                   [](entry const& entry) -> bool {
+                                       return entry.proxy == _no_proxy;
+                                   }),
+                    queue.end());
+        if (entries.empty()) {
+            return;
+        }
+
+        radix(entries);
+        first = (size_t)(std::upper_bound(queue.begin(), queue.end(),
+                                          entries.front(), precedes) -
+                         queue.begin());
+        middle = queue.size();
+        queue.insert(queue.end(), entries.begin(), entries.end());
+        std::inplace_merge(queue.begin() + (std::ptrdiff_t)first,
+                           queue.begin() + (std::ptrdiff_t)middle,
+                           queue.end(), precedes);
+    };
+
+    space_first = _space_queue.size();
+    plane_first = _plane_queue.size();
+    changed = false;
+    std::for_each(
+        renderable::invalidated().begin(), renderable::invalidated().end(),
+        [&](size_t proxy) -> void {
+            if (proxies.queued[proxy] != _no_key &&
+                !erase(_space_queue, space_first, proxy)) {
+                changed |= erase(_plane_queue, plane_first, proxy);
+            }
+            proxies.queued[proxy] = _no_key;
+            if (!(bool)proxies.visible[proxy]) {
+                return;
+            }
+
+            if ((bool)proxies.spatial[proxy]) {
+                space.push_back({key(proxies.z[proxy], proxies.priority[proxy]),
+                                 proxies.serial[proxy], proxy});
+                proxies.queued[proxy] = space.back().key;
+            } else {
+                plane.push_back({key(0, proxies.priority[proxy]),
+                                 proxies.serial[proxy], proxy});
+                proxies.queued[proxy] = plane.back().key;
+                changed = true;
+            }
+        });
+
+    merge(_space_queue, space_first, space);
+    merge(_plane_queue, plane_first, plane);
+    if (changed) {
+        invalidate_plane();
+    }
+}
+
+uint64_t wze::renderer::locate(float x, float y, float z) {
+    constexpr int64_t bits = 21;
+    constexpr int64_t offset = (int64_t)1 << (bits - 1);
+
+    std::function<uint64_t(float)> index;
+
+    index = [&](float component) -> uint64_t {
+        return (uint64_t)(std::clamp((int64_t)floorf(component / _cell_size),
+                                     -offset, offset - 1) +
+                          offset);
+    };
+
+    return index(x) << (bits * 2) | index(y) << bits | index(z);
+}
+
+void wze::renderer::leave(size_t proxy) {
+    std::unordered_map<uint64_t, cell>::iterator iterator;
+
+    iterator = _grid.find(renderable::proxies().cell[proxy]);
+    if (iterator == _grid.end()) {
+        return;
+    }
+
+    iterator->second.proxies.erase(std::find(iterator->second.proxies.begin(),
+                                             iterator->second.proxies.end(),
+                                             proxy));
+    if (iterator->second.proxies.empty()) {
+        _grid.erase(iterator);
+    }
+}
+
+void wze::renderer::relocate() {
+    render_proxies& proxies = renderable::proxies();
+
+    std::for_each(
+        renderable::displaced().begin(), renderable::displaced().end(),
+        [&](size_t proxy) -> void {
+            uint64_t key;
+            cell* target;
+
+            if (!(bool)proxies.spatial[proxy] && (bool)proxies.visible[proxy]) {
+                invalidate_plane();
+            }
+            key = (bool)proxies.spatial[proxy] && (bool)proxies.visible[proxy]
+                      ? locate(proxies.x[proxy], proxies.y[proxy],
+                               proxies.z[proxy])
+                      : _no_cell;
+            if (key != proxies.cell[proxy]) {
+                leave(proxy);
+                proxies.cell[proxy] = key;
+                if (key == _no_cell) {
+                    return;
+                }
+                target = &_grid[key];
+                target->proxies.push_back(proxy);
+            } else if (key == _no_cell) {
+                return;
+            } else {
+                target = &_grid.at(key);
+            }
+
+            target->radius = std::max(
+                target->radius,
+                math::length(proxies.width[proxy], proxies.height[proxy]) / 2);
+        });
+}
+
+void wze::renderer::cull() {
+    constexpr uint64_t bits = 21;
+    constexpr uint64_t mask = ((uint64_t)1 << bits) - 1;
+    constexpr float offset = (float)((uint64_t)1 << (bits - 1));
+
+    float reach;
+
+    ++_frame;
+
+    reach = std::max(
+        {math::length(origo_x(), origo_y()),
+         math::length((float)window::width() - origo_x(), origo_y()),
+         math::length(origo_x(), (float)window::height() - origo_y()),
+         math::length((float)window::width() - origo_x(),
+                      (float)window::height() - origo_y())});
+
+    std::for_each(
+        _grid.begin(), _grid.end(),
+        [&](std::pair<uint64_t const, cell> const& target) -> void {
+            float left;
+            float top;
+            float depth;
+
+            left = ((float)(target.first >> (bits * 2) & mask) - offset) *
+                   _cell_size;
+            top = ((float)(target.first >> bits & mask) - offset) * _cell_size;
+            depth = ((float)(target.first & mask) - offset + 1) * _cell_size -
+                    camera::z();
+
+            if (depth <= 0 ||
+                (0 < camera::focus() &&
+                 reach * depth / camera::focus() + target.second.radius <
+                     math::length(
+                         std::max({left - camera::x(), 0.F,
+                                   camera::x() - left - _cell_size}),
+                         std::max({top - camera::y(), 0.F,
+                                   camera::y() - top - _cell_size})))) {
+                return;
+            }
+
+            std::for_each(target.second.proxies.begin(),
+                          target.second.proxies.end(),
+                          [](size_t proxy) -> void {
+                              renderable::proxies().frame[proxy] = _frame;
+                          });
+        });
+}
+
+void wze::renderer::capture(frame& frame, size_t slices) {
+    std::function<size_t(entry const&)> proxy;
+
+    proxy = [](entry const& entry) -> size_t {
+        return entry.proxy;
+    };
+
+    if (pipelined() || (_interpolation < 1 && !_previous.serial.empty())) {
+        frame.snapshot = renderable::proxies();
+        frame.proxies = &frame.snapshot;
+        if (_interpolation < 1) {
+            blend(frame.snapshot);
+        }
+    } else {
+        frame.proxies = &renderable::proxies();
+    }
+    frame.space.resize(_space_queue.size());
+    std::transform(_space_queue.begin(), _space_queue.end(),
+                   frame.space.begin(), proxy);
+    frame.plane.resize(_plane_queue.size());
+    std::transform(_plane_queue.begin(), _plane_queue.end(),
+                   frame.plane.begin(), proxy);
+    frame.view = camera::capture();
+    frame.origo_x = origo_x();
+    frame.origo_y = origo_y();
+    frame.stamp = _frame;
+    frame.redraw = !plane_retained() || _plane_invalid;
+    _plane_invalid = false;
+    frame.slices.resize(slices);
+}
+
+void wze::renderer::blend(render_proxies& proxies) {
+    size_t proxy;
+
+    for (proxy = 0;
+         proxy != std::min(proxies.owner.size(), _previous.serial.size());
+         ++proxy) {
+        if (proxies.serial[proxy] == _previous.serial[proxy]) {
+            proxies.x[proxy] = _previous.x[proxy] +
+                               (proxies.x[proxy] - _previous.x[proxy]) *
+                                   _interpolation;
+            proxies.y[proxy] = _previous.y[proxy] +
+                               (proxies.y[proxy] - _previous.y[proxy]) *
+                                   _interpolation;
+            proxies.angle[proxy] =
+                _previous.angle[proxy] +
+                remainderf(proxies.angle[proxy] - _previous.angle[proxy],
+                           2 * math::pi()) *
+                    _interpolation;
+        }
+    }
+}
+
+bool wze::renderer::invisible(frame const& frame, size_t proxy) {
+    render_proxies const& proxies = *frame.proxies;
+
+    return !(bool)proxies.visible[proxy] || !(bool)proxies.color[proxy].a ||
+           !(bool)proxies.texture[proxy] || !(bool)proxies.width[proxy] ||
+           !(bool)proxies.height[proxy];
+}
+
+bool wze::renderer::culled(frame const& frame, size_t proxy) {
+    render_proxies const& proxies = *frame.proxies;
+
+    return (bool)proxies.spatial[proxy] &&
+           (proxies.frame[proxy] != frame.stamp ||
+            proxies.z[proxy] <= frame.view.z);
+}
+
+void wze::renderer::transform(frame& frame, size_t proxy) {
+    SDL_FRect& screen_area = frame.proxies->screen_area[proxy];
+
+    screen_area.x = frame.origo_x + screen_area.x - screen_area.w / 2;
+    screen_area.y = frame.origo_y + screen_area.y - screen_area.h / 2;
+}
+
+bool wze::renderer::offscreen(frame const& frame, size_t proxy) {
+    SDL_FRect const& screen_area = frame.proxies->screen_area[proxy];
+
+    return screen_area.x + screen_area.w < 0 ||
+           (float)window::width() <= screen_area.x ||
+           screen_area.y + screen_area.h < 0 ||
+           (float)window::height() <= screen_area.y;
+}
+
+void wze::renderer::prepare(frame& frame, size_t index) {
+    render_proxies& proxies = *frame.proxies;
+    slice& target = frame.slices.at(index);
+    size_t first;
+    size_t last;
+    size_t proxy;
+    layer_stats* layer;
+
+    first = proxies.owner.size() * index / frame.slices.size();
+    last = proxies.owner.size() * (index + 1) / frame.slices.size();
+
+    target.space_stats = target.plane_stats = {};
+    for (proxy = first; proxy != last; ++proxy) {
+        proxies.drawn[proxy] = (uint8_t)false;
+        if (!(bool)proxies.owner[proxy]) {
+            continue;
+        }
+
+        layer = (bool)proxies.spatial[proxy] ? &target.space_stats
+                                             : &target.plane_stats;
+        ++layer->considered;
+        if (invisible(frame, proxy)) {
+            ++layer->invisible;
+        } else if (culled(frame, proxy)) {
+            ++layer->culled;
+        } else {
+            proxies.drawn[proxy] = (uint8_t)true;
+        }
+    }
+
+    camera::project(frame.view, proxies, first, last);
+
+    for (proxy = first; proxy != last; ++proxy) {
+        if ((bool)proxies.drawn[proxy]) {
+            layer = (bool)proxies.spatial[proxy] ? &target.space_stats
+                                                 : &target.plane_stats;
+            transform(frame, proxy);
+            if (offscreen(frame, proxy)) {
+                proxies.drawn[proxy] = (uint8_t)false;
+                ++layer->culled;
+            } else {
+                ++layer->drawn;
+            }
+        }
+    }
+}
+
+bool wze::renderer::failed(int32_t result) {
+    ++_stats.calls;
+    return (bool)result;
+}
+
+bool wze::renderer::modulate(texture* texture, uint8_t color_r,
+                             uint8_t color_g, uint8_t color_b,
+                             uint8_t color_a) {
+    std::unordered_map<wze::texture*, SDL_Color>::iterator iterator;
+    bool inserted;
+
+    std::tie(iterator, inserted) =
+        _modulations.try_emplace(texture, SDL_Color{color_r, color_g, color_b,
+                                                    color_a});
+    if (!inserted && iterator->second.r == color_r &&
+        iterator->second.g == color_g && iterator->second.b == color_b &&
+        iterator->second.a == color_a) {
+        return false;
+    }
+
+    iterator->second = {color_r, color_g, color_b, color_a};
+    if (failed(SDL_SetTextureColorMod(texture, color_r, color_g, color_b)) ||
+        failed(SDL_SetTextureAlphaMod(texture, color_a))) {
+        _modulations.erase(iterator);
+        return true;
+    }
+
+    return false;
+}
+
+float wze::renderer::elapsed(uint64_t start) {
+    constexpr float milliseconds = 1000;
+
+    return (float)(SDL_GetPerformanceCounter() - start) * milliseconds /
+           (float)SDL_GetPerformanceFrequency();
+}
 
 void wze::renderer::open_frame() {
-    if ((bool)SDL_SetRenderTarget(base(), nullptr) ||
-        (bool)SDL_SetRenderDrawColor(base(), background_color_r(),
-                                     background_color_g(), background_color_b(),
-                                     std::numeric_limits<uint8_t>::max()) ||
-        (bool)SDL_RenderClear(base()) ||
+    if (failed(SDL_SetRenderTarget(base(), nullptr)) ||
+        failed(SDL_SetRenderDrawColor(
+            base(), background_color_r(), background_color_g(),
+            background_color_b(), std::numeric_limits<uint8_t>::max())) ||
+        failed(SDL_RenderClear(base())) ||
         (background_texture() &&
-         ((bool)SDL_SetTextureColorMod(
-              background_texture().get(), background_color_r(),
-              background_color_g(), background_color_b()) ||
-          (bool)SDL_RenderCopy(base(), background_texture().get(), nullptr,
-                               nullptr)))) {
+         (modulate(background_texture().get(), background_color_r(),
+                   background_color_g(), background_color_b(),
+                   std::numeric_limits<uint8_t>::max()) ||
+          failed(SDL_RenderCopy(base(), background_texture().get(), nullptr,
+                                nullptr))))) {
         throw exception(SDL_GetError());
     }
 }
 
-void wze::renderer::open_space() {
-    if ((bool)SDL_SetRenderTarget(base(), _space.get()) ||
-        (bool)SDL_SetRenderDrawColor(base(), 0, 0, 0, 0) ||
-        (bool)SDL_RenderClear(base()) ||
+bool wze::renderer::identity(uint8_t color_r, uint8_t color_g,
+                             uint8_t color_b, uint8_t color_a) {
+    return color_r == std::numeric_limits<uint8_t>::max() &&
+           color_g == std::numeric_limits<uint8_t>::max() &&
+           color_b == std::numeric_limits<uint8_t>::max() &&
+           color_a == std::numeric_limits<uint8_t>::max();
+}
+
+void wze::renderer::plan(frame const& frame) {
+    std::function<void(layer_stats&, layer_stats const&)> add;
+
+    add = [](layer_stats& total, layer_stats const& slice) -> void {
+        total.considered += slice.considered;
+        total.invisible += slice.invisible;
+        total.culled += slice.culled;
+        total.drawn += slice.drawn;
+    };
+
+    if (frame.redraw) {
+        ++_plane_redraws;
+    } else {
+        ++_plane_reuses;
+    }
+
+    std::for_each(frame.slices.begin(), frame.slices.end(),
+                  [&](slice const& slice) -> void {
+                      add(_stats.space, slice.space_stats);
+                      add(_stats.plane, slice.plane_stats);
+                  });
+
+    _space_pass =
+        (bool)space_color_a() && (space_texture() || (bool)_stats.space.drawn)
+            ? PASS_TARGET
+            : PASS_NONE;
+    if (frame.redraw) {
+        _plane_pass = (bool)plane_color_a() && (bool)_stats.plane.drawn
+                          ? PASS_TARGET
+                          : PASS_NONE;
+    }
+
+    if (_space_pass == PASS_TARGET && _plane_pass == PASS_NONE &&
+        resolution_scale() == 1 &&
+        identity(space_color_r(), space_color_g(), space_color_b(),
+                 space_color_a())) {
+        _space_pass = PASS_DIRECT;
+    } else if (_space_pass == PASS_NONE && _plane_pass == PASS_TARGET &&
+               !plane_retained() &&
+               identity(plane_color_r(), plane_color_g(), plane_color_b(),
+                        plane_color_a())) {
+        _plane_pass = PASS_DIRECT;
+    }
+}
+
+void wze::renderer::open_space(frame const& frame) {
+    if ((_space_pass == PASS_TARGET &&
+         (failed(SDL_SetRenderTarget(base(), _space.get())) ||
+          failed(SDL_RenderSetScale(base(), resolution_scale(),
+                                    resolution_scale())) ||
+          failed(SDL_SetRenderDrawColor(base(), 0, 0, 0, 0)) ||
+          failed(SDL_RenderClear(base())))) ||
         (space_texture() &&
-         ((bool)SDL_SetTextureColorMod(space_texture().get(), space_color_r(),
-                                       space_color_g(), space_color_b()) ||
-          (bool)SDL_SetTextureAlphaMod(space_texture().get(),
-                                       space_color_a()) ||
-          (bool)SDL_RenderCopyExF(base(), space_texture().get(), nullptr,
-                                  &_space_area,
-                                  (double)math::to_degrees(-camera::angle()),
-                                  nullptr, SDL_FLIP_NONE)))) {
+         (modulate(space_texture().get(), space_color_r(), space_color_g(),
+                   space_color_b(), space_color_a()) ||
+          failed(SDL_RenderCopyExF(
+              base(), space_texture().get(), nullptr, &_space_area,
+              (double)math::to_degrees(-frame.view.angle), nullptr,
+              SDL_FLIP_NONE))))) {
         throw exception(SDL_GetError());
     }
 }
 
 void wze::renderer::open_plane() {
-    if ((bool)SDL_SetRenderTarget(base(), _plane.get()) ||
-        (bool)SDL_SetRenderDrawColor(base(), 0, 0, 0, 0) ||
-        (bool)SDL_RenderClear(base())) {
+    if (_plane_pass == PASS_TARGET &&
+        (failed(SDL_SetRenderTarget(base(), _plane.get())) ||
+         failed(SDL_SetRenderDrawColor(base(), 0, 0, 0, 0)) ||
+         failed(SDL_RenderClear(base())))) {
         throw exception(SDL_GetError());
     }
 }
 
-bool wze::renderer::invisible(renderable const& instance) {
-    return !instance.visible() ||
-           (instance.spatial() && instance.z() <= camera::z()) ||
-           !(bool)instance.color_a() || !instance.texture() ||
-           !(bool)instance.width() || !(bool)instance.height();
+void wze::renderer::emit(slice& slice, SDL_FPoint const& center,
+                         float half_width, float half_height,
+                         std::array<float, 4> const& transformation_matrix,
+                         SDL_Color const& color, SDL_FRect const& source,
+                         uint8_t flip) {
+    float left;
+    float right;
+    float top;
+    float bottom;
+
+    left = source.x;
+    right = source.x + source.w;
+    top = source.y;
+    bottom = source.y + source.h;
+    if ((bool)(flip & FLIP_HORIZONTAL)) {
+        std::swap(left, right);
+    }
+    if ((bool)(flip & FLIP_VERTICAL)) {
+        std::swap(top, bottom);
+    }
+
+    slice.vertices.push_back(
+        {{center.x + math::transform_x(-half_width, -half_height,
+                                       transformation_matrix),
+          center.y + math::transform_y(-half_width, -half_height,
+                                       transformation_matrix)},
+         color,
+         {left, top}});
+    slice.vertices.push_back(
+        {{center.x + math::transform_x(half_width, -half_height,
+                                       transformation_matrix),
+          center.y + math::transform_y(half_width, -half_height,
+                                       transformation_matrix)},
+         color,
+         {right, top}});
+    slice.vertices.push_back(
+        {{center.x + math::transform_x(half_width, half_height,
+                                       transformation_matrix),
+          center.y + math::transform_y(half_width, half_height,
+                                       transformation_matrix)},
+         color,
+         {right, bottom}});
+    slice.vertices.push_back(
+        {{center.x + math::transform_x(-half_width, half_height,
+                                       transformation_matrix),
+          center.y + math::transform_y(-half_width, half_height,
+                                       transformation_matrix)},
+         color,
+         {left, bottom}});
+}
+
+void wze::renderer::render(frame const& frame, slice& slice,
+                          std::vector<batch>& batches, size_t proxy) {
+    render_proxies const& proxies = *frame.proxies;
+    SDL_FRect const& screen_area = proxies.screen_area[proxy];
+    SDL_FRect const& source = proxies.source[proxy];
+    SDL_Color const& color = proxies.color[proxy];
+    SDL_FPoint center;
+    float scale;
+    std::array<float, 4> rotation;
+    std::array<float, 4> offset;
+
+    if (batches.empty() || batches.back().texture != proxies.texture[proxy]) {
+        batches.push_back({proxies.texture[proxy], slice.vertices.size(), 0});
+    }
+
+    center = {screen_area.x + screen_area.w / 2,
+              screen_area.y + screen_area.h / 2};
+
+    if (!proxies.quads[proxy]) {
+        emit(slice, center, screen_area.w / 2, screen_area.h / 2,
+             math::transformation_matrix(proxies.screen_angle[proxy], 1),
+             color, source, proxies.flip[proxy]);
+        batches.back().count += 4;
+        return;
+    }
+
+    scale = screen_area.w / proxies.width[proxy];
+    rotation = math::transformation_matrix(
+        proxies.screen_angle[proxy] - proxies.angle[proxy], 1);
+    offset = math::transformation_matrix(
+        proxies.screen_angle[proxy] - proxies.angle[proxy], scale);
+    std::for_each(
+        proxies.quads[proxy]->begin(), proxies.quads[proxy]->end(),
+        [&](render_quad const& quad) -> void {
+            emit(slice,
+                 {center.x + math::transform_x(quad.x, quad.y, offset),
+                  center.y + math::transform_y(quad.x, quad.y, offset)},
+                 quad.width * scale / 2, quad.height * scale / 2,
+                 (bool)quad.angle
+                     ? math::transformation_matrix(
+                           proxies.screen_angle[proxy] -
+                               proxies.angle[proxy] + quad.angle,
+                           1)
+                     : rotation,
+                 {(uint8_t)(quad.color.r * color.r /
+                            std::numeric_limits<uint8_t>::max()),
+                  (uint8_t)(quad.color.g * color.g /
+                            std::numeric_limits<uint8_t>::max()),
+                  (uint8_t)(quad.color.b * color.b /
+                            std::numeric_limits<uint8_t>::max()),
+                  (uint8_t)(quad.color.a * color.a /
+                            std::numeric_limits<uint8_t>::max())},
+                 {source.x + quad.source.x * source.w,
+                  source.y + quad.source.y * source.h,
+                  quad.source.w * source.w, quad.source.h * source.h},
+                 proxies.flip[proxy]);
+        });
+    batches.back().count += 4 * proxies.quads[proxy]->size();
+}
+
+void wze::renderer::group(frame const& frame, slice& slice,
+                         std::vector<batch>& batches,
+                         std::vector<size_t>::const_iterator first,
+                         std::vector<size_t>::const_iterator last) {
+    render_proxies const& proxies = *frame.proxies;
+
+    slice.tie.clear();
+    slice.ranks.clear();
+    std::for_each(first, last, [&](size_t proxy) -> void {
+        if ((bool)proxies.drawn[proxy]) {
+            slice.tie.emplace_back(
+                slice.ranks.emplace(proxies.texture[proxy], slice.ranks.size())
+                    .first->second,
+                proxy);
+        }
+    });
+
+    if (1 < slice.ranks.size() && slice.ranks.size() < slice.tie.size()) {
+        std::stable_sort(slice.tie.begin(), slice.tie.end(),
+                         [](std::pair<size_t, size_t> const& tie1,
+                            std::pair<size_t, size_t> const& tie2) -> bool {
+                             return tie1.first < tie2.first;
+                         });
+    }
+
+    std::for_each(slice.tie.begin(), slice.tie.end(),
+                  [&](std::pair<size_t, size_t> const& tie) -> void {
+                      render(frame, slice, batches, tie.second);
+                  });
+}
+
+void wze::renderer::build(frame& frame, size_t index) {
+    render_proxies const& proxies = *frame.proxies;
+    slice& target = frame.slices.at(index);
+    std::function<void(std::vector<size_t> const&, bool, std::vector<batch>&)>
+        append;
+
+    append = [&](std::vector<size_t> const& queue, bool spatial,
+                 std::vector<batch>& batches) -> void {
+        std::vector<size_t>::const_iterator first;
+        std::vector<size_t>::const_iterator last;
+        std::vector<size_t>::const_iterator tie;
+
+        first = queue.begin() +
+                (std::ptrdiff_t)(queue.size() * index / frame.slices.size());
+        last = queue.begin() + (std::ptrdiff_t)(queue.size() * (index + 1) /
+                                                frame.slices.size());
+
+        for (; first != last; first = tie) {
+            tie = std::find_if(first + 1, last, [&](size_t proxy) -> bool {
+                return (spatial && proxies.z[proxy] != proxies.z[*first]) ||
+                       proxies.priority[proxy] != proxies.priority[*first];
+            });
+            group(frame, target, batches, first, tie);
+        }
+    };
+
+    target.vertices.clear();
+    target.space.clear();
+    target.plane.clear();
+    append(frame.space, true, target.space);
+    if (frame.redraw) {
+        append(frame.plane, false, target.plane);
+    }
+}
+
+int32_t wze::renderer::work(void* data) {
+    size_t index;
+
+    index = (size_t)(uintptr_t)data;
+    while (true) {
+        SDL_SemWait(_start);
+        prepare(_frames.at(_current), index);
+        barrier();
+        build(_frames.at(_current), index);
+        SDL_SemPost(_done);
+    }
+}
+
+void wze::renderer::barrier() {
+    size_t worker;
+
+    if ((size_t)SDL_AtomicAdd(&_arrived, 1) + 1 != _workers) {
+        SDL_SemWait(_phase);
+        return;
+    }
+
+    SDL_AtomicSet(&_arrived, 0);
+    for (worker = 1; worker != _workers; ++worker) {
+        SDL_SemPost(_phase);
+    }
 }
 
-void wze::renderer::transform(renderable& instance) {
-    instance.set_screen_area(
-        {origo_x() + instance.screen_area().x - instance.screen_area().w / 2,
-         origo_y() + instance.screen_area().y - instance.screen_area().h / 2,
-         instance.screen_area().w, instance.screen_area().h});
+void wze::renderer::wait() {
+    size_t worker;
+
+    for (worker = 0; worker != _workers; ++worker) {
+        SDL_SemWait(_done);
+    }
 }
 
-bool wze::renderer::offscreen(renderable const& instance) {
-    return instance.screen_area().x + instance.screen_area().w < 0 ||
-           (float)window::width() <= instance.screen_area().x ||
-           instance.screen_area().y + instance.screen_area().h < 0 ||
-           (float)window::height() <= instance.screen_area().y;
+void wze::renderer::publish(frame const& frame) {
+    render_proxies& proxies = renderable::proxies();
+    size_t proxy;
+
+    for (proxy = 0;
+         proxy != std::min(proxies.owner.size(), frame.snapshot.owner.size());
+         ++proxy) {
+        if (proxies.serial[proxy] == frame.snapshot.serial[proxy]) {
+            proxies.screen_area[proxy] = frame.snapshot.screen_area[proxy];
+            proxies.screen_angle[proxy] = frame.snapshot.screen_angle[proxy];
+        }
+    }
+}
+
+void wze::renderer::flush(slice const& slice,
+                         std::vector<batch> const& batches,
+                         wze::texture*& bound) {
+    std::for_each(
+        batches.begin(), batches.end(), [&](batch const& batch) -> void {
+            int32_t vertex;
+
+            for (vertex = (int32_t)(_indices.size() / 6 * 4);
+                 _indices.size() < batch.count / 4 * 6; vertex += 4) {
+                _indices.insert(_indices.end(),
+                                {vertex, vertex + 1, vertex + 2, vertex + 2,
+                                 vertex + 3, vertex});
+            }
+
+            if (batch.texture != bound) {
+                ++_stats.switches;
+                bound = batch.texture;
+            }
+            if (failed(SDL_RenderGeometry(
+                    base(), batch.texture, &slice.vertices.at(batch.first),
+                    (int32_t)batch.count, _indices.data(),
+                    (int32_t)(batch.count / 4 * 6)))) {
+                throw exception(SDL_GetError());
+            }
+        });
 }
 
-void wze::renderer::render(renderable const& instance) {
-    if ((bool)SDL_SetTextureColorMod(instance.texture().get(),
-                                     instance.color_r(), instance.color_g(),
-                                     instance.color_b()) ||
-        (bool)SDL_SetTextureAlphaMod(instance.texture().get(),
-                                     instance.color_a()) ||
-        (bool)SDL_RenderCopyExF(
-            base(), instance.texture().get(), nullptr, &instance.screen_area(),
-            (double)math::to_degrees(instance.screen_angle()), nullptr,
-            (SDL_RendererFlip)instance.flip())) {
+void wze::renderer::read() {
+    constexpr int32_t depth = 32;
+
+    int32_t width;
+    int32_t height;
+
+    if (failed(SDL_GetRendererOutputSize(base(), &width, &height))) {
+        throw exception(SDL_GetError());
+    }
+
+    if (!_screenshot || _screenshot.use_count() != 1 ||
+        _screenshot->w != width || _screenshot->h != height) {
+        _screenshot = {SDL_CreateRGBSurfaceWithFormat(
+                           0, width, height, depth, SDL_PIXELFORMAT_RGBA32),
+                       SDL_FreeSurface};
+        if (!_screenshot) {
+            throw exception(SDL_GetError());
+        }
+    }
+
+    if (failed(SDL_RenderReadPixels(base(), nullptr,
+                                    _screenshot->format->format,
+                                    _screenshot->pixels,
+                                    _screenshot->pitch))) {
         throw exception(SDL_GetError());
     }
 }
 
 void wze::renderer::close_frame() {
-    if ((bool)SDL_SetRenderTarget(base(), nullptr) ||
-        (bool)SDL_SetTextureColorMod(_space.get(), space_color_r(),
-                                     space_color_g(), space_color_b()) ||
-        (bool)SDL_SetTextureAlphaMod(_space.get(), space_color_a()) ||
-        (bool)SDL_RenderCopy(base(), _space.get(), nullptr, nullptr) ||
-        (bool)SDL_SetTextureColorMod(_plane.get(), plane_color_r(),
-                                     plane_color_g(), plane_color_b()) ||
-        (bool)SDL_SetTextureAlphaMod(_plane.get(), plane_color_a()) ||
-        (bool)SDL_RenderCopy(base(), _plane.get(), nullptr, nullptr)) {
+    if (failed(SDL_SetRenderTarget(base(), nullptr)) ||
+        (_space_pass == PASS_TARGET &&
+         (modulate(_space.get(), space_color_r(), space_color_g(),
+                   space_color_b(), space_color_a()) ||
+          failed(SDL_RenderCopy(base(), _space.get(), nullptr, nullptr)))) ||
+        (_plane_pass == PASS_TARGET &&
+         (modulate(_plane.get(), plane_color_r(), plane_color_g(),
+                   plane_color_b(), plane_color_a()) ||
+          failed(SDL_RenderCopy(base(), _plane.get(), nullptr, nullptr))))) {
         throw exception(SDL_GetError());
     }
+    if (readback()) {
+        read();
+    }
+    ++_stats.calls;
+}
+
+void wze::renderer::submit(frame const& frame) {
+    uint64_t begin;
+    uint64_t start;
+    wze::texture* bound;
+
+    begin = SDL_GetPerformanceCounter();
+    plan(frame);
+
+    start = SDL_GetPerformanceCounter();
+    open_frame();
+    _stats.open_frame_time = elapsed(start);
+    if (_space_pass != PASS_NONE) {
+        start = SDL_GetPerformanceCounter();
+        open_space(frame);
+        _stats.open_space_time = elapsed(start);
+        bound = nullptr;
+        std::for_each(frame.slices.begin(), frame.slices.end(),
+                      [&](slice const& slice) -> void {
+                          flush(slice, slice.space, bound);
+                      });
+    }
+    if (_plane_pass != PASS_NONE && frame.redraw) {
+        start = SDL_GetPerformanceCounter();
+        open_plane();
+        _stats.open_plane_time = elapsed(start);
+        bound = nullptr;
+        std::for_each(frame.slices.begin(), frame.slices.end(),
+                      [&](slice const& slice) -> void {
+                          flush(slice, slice.plane, bound);
+                      });
+    }
+    start = SDL_GetPerformanceCounter();
+    close_frame();
+    _stats.close_frame_time = elapsed(start);
+    if (0 < resolution_budget()) {
+        adapt(elapsed(begin));
+    }
     SDL_RenderPresent(base());
 }
 
+void wze::renderer::resize_space() {
+    _modulations.erase(_space.get());
+    _space = {SDL_CreateTexture(
+                  base(), SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET,
+                  std::max((int32_t)roundf((float)window::width() *
+                                           resolution_scale()),
+                           1),
+                  std::max((int32_t)roundf((float)window::height() *
+                                           resolution_scale()),
+                           1)),
+              SDL_DestroyTexture};
+    if (!_space ||
+        (bool)SDL_SetTextureBlendMode(_space.get(), SDL_BLENDMODE_BLEND) ||
+        (bool)SDL_SetTextureScaleMode(_space.get(), SDL_ScaleModeLinear)) {
+        throw exception(SDL_GetError());
+    }
+}
+
+void wze::renderer::adapt(float submit_time) {
+    constexpr float smoothing = .1;
+    constexpr float headroom = .8;
+
+    _submit_time += (submit_time - _submit_time) * smoothing;
+    if (resolution_budget() < _submit_time) {
+        set_resolution_scale(resolution_scale() - _resolution_step);
+    } else if (_submit_time < resolution_budget() * headroom) {
+        set_resolution_scale(resolution_scale() + _resolution_step);
+    }
+}
+
 float wze::renderer::origo_x() {
     return _origo_x;
 }
 
 void wze::renderer::set_origo_x(float origo_x) {
+    if (origo_x != _origo_x) {
+        invalidate_plane();
+    }
     _origo_x = origo_x;
 }
 
@@ -154,6 +1010,9 @@ float wze::renderer::origo_y() {
 }
 
 void wze::renderer::set_origo_y(float origo_y) {
+    if (origo_y != _origo_y) {
+        invalidate_plane();
+    }
     _origo_y = origo_y;
 }
 
@@ -191,6 +1050,7 @@ std::shared_ptr<wze::texture> const& wze::renderer::background_texture() {
 
 void wze::renderer::set_background_texture(
     std::shared_ptr<texture> const& background_texture) {
+    _modulations.erase(_background_texture.get());
     _background_texture = background_texture;
 }
 
@@ -232,6 +1092,7 @@ std::shared_ptr<wze::texture> const& wze::renderer::space_texture() {
 
 void wze::renderer::set_space_texture(
     std::shared_ptr<texture> const& space_texture) {
+    _modulations.erase(_space_texture.get());
     _space_texture = space_texture;
 }
 
@@ -267,10 +1128,137 @@ void wze::renderer::set_plane_color_a(uint8_t plane_color_a) {
     _plane_color_a = plane_color_a;
 }
 
-void wze::renderer::initialize() {
+bool wze::renderer::plane_retained() {
+    return _plane_retained;
+}
+
+void wze::renderer::set_plane_retained(bool plane_retained) {
+    _plane_retained = plane_retained;
+    invalidate_plane();
+}
+
+void wze::renderer::invalidate_plane() {
+    _plane_invalid = true;
+}
+
+size_t wze::renderer::plane_reuses() {
+    return _plane_reuses;
+}
+
+float wze::renderer::resolution_scale() {
+    return _resolution_scale;
+}
+
+void wze::renderer::set_resolution_scale(float resolution_scale) {
+    resolution_scale =
+        std::clamp(roundf(resolution_scale / _resolution_step) *
+                       _resolution_step,
+                   _min_resolution_scale, 1.F);
+    if (resolution_scale != _resolution_scale) {
+        _resolution_scale = resolution_scale;
+        resize_space();
+    }
+}
+
+float wze::renderer::resolution_budget() {
+    return _resolution_budget;
+}
+
+void wze::renderer::set_resolution_budget(float resolution_budget) {
+    _resolution_budget = resolution_budget;
+    _submit_time = resolution_budget;
+}
+
+size_t wze::renderer::plane_redraws() {
+    return _plane_redraws;
+}
+
+bool wze::renderer::pipelined() {
+    return _pipelined;
+}
+
+void wze::renderer::set_pipelined(bool pipelined) {
+    size_t workers;
+    SDL_Thread* thread;
+
+    if (_pending) {
+        wait();
+        _pending = false;
+    }
+
+    if (pipelined && !(bool)_workers) {
+        if (!(bool)_start) {
+            _start = SDL_CreateSemaphore(0);
+            _phase = SDL_CreateSemaphore(0);
+            _done = SDL_CreateSemaphore(0);
+            if (!(bool)_start || !(bool)_phase || !(bool)_done) {
+                throw exception(SDL_GetError());
+            }
+            if ((bool)std::atexit([]() -> void {
+                    if (_pending) {
+                        wait();
+                    }
+                })) {
+                throw exception("Cannot register the workers for shutdown");
+            }
+        }
+
+        workers = std::clamp((size_t)std::max(SDL_GetCPUCount() - 1, 1),
+                             (size_t)1, _max_workers);
+        for (; _workers != workers; ++_workers) {
+            thread = SDL_CreateThread(work, "wze_renderer",
+                                      (void*)(uintptr_t)_workers);
+            if (!(bool)thread) {
+                break;
+            }
+            SDL_DetachThread(thread);
+        }
+    }
+
+    _pipelined = pipelined && (bool)_workers;
+    if (!renderer::pipelined()) {
+        std::for_each(_released.begin(), _released.end(), SDL_DestroyTexture);
+        _released.clear();
+    }
+}
+
+wze::render_stats const& wze::renderer::stats() {
+    return _stats;
+}
+
+bool wze::renderer::readback() {
+    return _readback;
+}
+
+void wze::renderer::set_readback(bool readback) {
+    _readback = readback;
+    if (!renderer::readback()) {
+        _screenshot = {};
+    }
+}
+
+std::shared_ptr<wze::image> const& wze::renderer::screenshot() {
+    return _screenshot;
+}
+
+uint64_t wze::renderer::frame_hash() {
+    return assets::digest_image(screenshot());
+}
+
+void wze::renderer::release(texture* texture) {
+    if (pipelined()) {
+        _released.push_back(texture);
+    } else {
+        SDL_DestroyTexture(texture);
+    }
+}
+
+void wze::renderer::initialize(bool software) {
     set_origo_x((float)window::width() / 2);
     set_origo_y((float)window::height() / 2);
-    _base = SDL_CreateRenderer(window::base(), -1, SDL_RENDERER_ACCELERATED);
+    _base = SDL_CreateRenderer(window::base(), -1,
+                               software ? SDL_RENDERER_SOFTWARE
+                                        : SDL_RENDERER_ACCELERATED);
     if (!(bool)base() || (bool)SDL_RenderSetLogicalSize(base(), window::width(),
                                                         window::height())) {
         throw exception(SDL_GetError());
@@ -279,14 +1267,9 @@ void wze::renderer::initialize() {
     set_background_color_g(0);
     set_background_color_b(0);
     set_background_texture({});
-    _space = {SDL_CreateTexture(base(), SDL_PIXELFORMAT_RGBA8888,
-                                SDL_TEXTUREACCESS_TARGET, window::width(),
-                                window::height()),
-              SDL_DestroyTexture};
-    if (!_space ||
-        (bool)SDL_SetTextureBlendMode(_space.get(), SDL_BLENDMODE_BLEND)) {
-        throw exception(SDL_GetError());
-    }
+    _resolution_scale = 1;
+    resize_space();
+    set_resolution_budget(0);
     set_space_color_r(std::numeric_limits<uint8_t>::max());
     set_space_color_g(std::numeric_limits<uint8_t>::max());
     set_space_color_b(std::numeric_limits<uint8_t>::max());
@@ -308,55 +1291,71 @@ void wze::renderer::initialize() {
     set_plane_color_g(std::numeric_limits<uint8_t>::max());
     set_plane_color_b(std::numeric_limits<uint8_t>::max());
     set_plane_color_a(std::numeric_limits<uint8_t>::max());
+    set_plane_retained(false);
+    set_readback(false);
 }
 
 void wze::renderer::update() {
-    std::vector<renderable const*> space;
-    std::vector<renderable const*> plane;
-
-    std::for_each(renderable::instances().begin(),
-                  renderable::instances().end(),
-                  [&](renderable* instance) -> void {
-                      if (invisible(*instance)) {
-                          return;
-                      }
-                      camera::project(*instance);
-                      transform(*instance);
-                      if (offscreen(*instance)) {
-                          return;
-                      }
-                      if (instance->spatial()) {
-                          space.push_back(instance);
-                      } else {
-                          plane.push_back(instance);
-                      }
-                  });
+    std::vector<texture*> released;
+    frame* previous;
+    size_t worker;
+    uint64_t start;
 
-    std::stable_sort(
-        space.begin(), space.end(),
-        [](renderable const* instance1, renderable const* instance2) -> bool {
-            return instance1->z() != instance2->z()
-                       ? instance2->z() < instance1->z()
-                       : instance1->priority() < instance2->priority();
-        });
-    std::stable_sort(
-        plane.begin(), plane.end(),
-        [](renderable const* instance1, renderable const* instance2) -> bool {
-            return instance1->priority() < instance2->priority();
-        });
+    _stats = {};
+    renderable::poll();
+    start = SDL_GetPerformanceCounter();
+    requeue();
+    _stats.sort_time = elapsed(start);
+    relocate();
+    renderable::validate();
+    cull();
 
-    open_frame();
-    open_space();
-    std::for_each(space.begin(), space.end(),
-                  [](renderable const* instance) -> void {
-                      render(*instance);
-                  });
-    open_plane();
-    std::for_each(plane.begin(), plane.end(),
-                  [](renderable const* instance) -> void {
-                      render(*instance);
-                  });
-    close_frame();
+    if (!pipelined()) {
+        capture(_frames.at(_current), 1);
+        prepare(_frames.at(_current), 0);
+        if (_frames.at(_current).proxies == &_frames.at(_current).snapshot) {
+            publish(_frames.at(_current));
+        }
+        build(_frames.at(_current), 0);
+        submit(_frames.at(_current));
+        return;
+    }
+
+    released.swap(_released);
+    previous = nullptr;
+    if (_pending) {
+        wait();
+        previous = &_frames.at(_current);
+        publish(*previous);
+        _current = (_current + 1) % _frames.size();
+    }
+
+    capture(_frames.at(_current), _workers);
+    for (worker = 0; worker != _workers; ++worker) {
+        SDL_SemPost(_start);
+    }
+    _pending = true;
+
+    if ((bool)previous) {
+        submit(*previous);
+    }
+    std::for_each(released.begin(), released.end(), SDL_DestroyTexture);
+}
+
+void wze::renderer::remember() {
+    render_proxies const& proxies = renderable::proxies();
+
+    _previous.serial = proxies.serial;
+    _previous.x = proxies.x;
+    _previous.y = proxies.y;
+    _previous.angle = proxies.angle;
+}
+
+void wze::renderer::interpolate(float interpolation) {
+    _interpolation = interpolation;
+    if (1 <= interpolation) {
+        _previous = {};
+    }
 }
 
 std::pair<float, float> wze::renderer::detransform(float x, float y) {
@@ -25,123 +25,148 @@
 #include <wizard_engine/sprite.hpp>
 
 float wze::sprite::x() const {
-    return _x;
+    return proxies().x[proxy()];
 }
 
 void wze::sprite::set_x(float x) {
-    _x = x;
+    proxies().x[proxy()] = x;
+    displace();
 }
 
 float wze::sprite::y() const {
-    return _y;
+    return proxies().y[proxy()];
 }
 
 void wze::sprite::set_y(float y) {
-    _y = y;
+    proxies().y[proxy()] = y;
+    displace();
 }
 
 float wze::sprite::z() const {
-    return _z;
+    return proxies().z[proxy()];
 }
 
 void wze::sprite::set_z(float z) {
-    _z = z;
+    proxies().z[proxy()] = z;
+    invalidate();
 }
 
 float wze::sprite::angle() const {
-    return _angle;
+    return proxies().angle[proxy()];
 }
 
 void wze::sprite::set_angle(float angle) {
-    _angle = angle;
+    proxies().angle[proxy()] = angle;
+    redraw();
 }
 
 float wze::sprite::width() const {
-    return _width;
+    return proxies().width[proxy()];
 }
 
 void wze::sprite::set_width(float width) {
-    _width = width;
+    proxies().width[proxy()] = width;
+    displace();
 }
 
 float wze::sprite::height() const {
-    return _height;
+    return proxies().height[proxy()];
 }
 
 void wze::sprite::set_height(float height) {
-    _height = height;
+    proxies().height[proxy()] = height;
+    displace();
 }
 
 bool wze::sprite::spatial() const {
-    return _spatial;
+    return (bool)proxies().spatial[proxy()];
 }
 
 void wze::sprite::set_spatial(bool spatial) {
-    _spatial = spatial;
+    proxies().spatial[proxy()] = (uint8_t)spatial;
+    invalidate();
 }
 
 std::shared_ptr<wze::texture> const& wze::sprite::texture() const {
-    return _texture;
+    return region().texture;
 }
 
 void wze::sprite::set_texture(std::shared_ptr<wze::texture> const& texture) {
-    _texture = texture;
+    set_region({texture, {0, 0, 1, 1}});
+}
+
+wze::texture_region const& wze::sprite::region() const {
+    return _region;
+}
+
+void wze::sprite::set_region(texture_region const& region) {
+    _region = region;
+    proxies().texture[proxy()] = region.texture.get();
+    proxies().source[proxy()] = region.source;
+    redraw();
 }
 
 uint8_t wze::sprite::color_r() const {
-    return _color_r;
+    return proxies().color[proxy()].r;
 }
 
 void wze::sprite::set_color_r(uint8_t color_r) {
-    _color_r = color_r;
+    proxies().color[proxy()].r = color_r;
+    redraw();
 }
 
 uint8_t wze::sprite::color_g() const {
-    return _color_g;
+    return proxies().color[proxy()].g;
 }
 
 void wze::sprite::set_color_g(uint8_t color_g) {
-    _color_g = color_g;
+    proxies().color[proxy()].g = color_g;
+    redraw();
 }
 
 uint8_t wze::sprite::color_b() const {
-    return _color_b;
+    return proxies().color[proxy()].b;
 }
 
 void wze::sprite::set_color_b(uint8_t color_b) {
-    _color_b = color_b;
+    proxies().color[proxy()].b = color_b;
+    redraw();
 }
 
 uint8_t wze::sprite::color_a() const {
-    return _color_a;
+    return proxies().color[proxy()].a;
 }
 
 void wze::sprite::set_color_a(uint8_t color_a) {
-    _color_a = color_a;
+    proxies().color[proxy()].a = color_a;
+    redraw();
 }
 
 wze::flip wze::sprite::flip() const {
-    return _flip;
+    return (enum flip)proxies().flip[proxy()];
 }
 
 void wze::sprite::set_flip(enum flip flip) {
-    _flip = flip;
+    proxies().flip[proxy()] = flip;
+    redraw();
 }
 
 bool wze::sprite::visible() const {
-    return _visible;
+    return (bool)proxies().visible[proxy()];
 }
 
 void wze::sprite::set_visible(bool visible) {
-    _visible = visible;
+    proxies().visible[proxy()] = (uint8_t)visible;
+    invalidate();
 }
 
 uint8_t wze::sprite::priority() const {
-    return _priority;
+    return proxies().priority[proxy()];
 }
 
 void wze::sprite::set_priority(uint8_t priority) {
-    _priority = priority;
+    proxies().priority[proxy()] = priority;
+    invalidate();
 }
 
 bool wze::sprite::animated() const {
@@ -224,7 +249,8 @@ wze::sprite::sprite(float x, float y, float z, float angle, float width,
                     uint8_t priority, bool animated, float x_offset,
                     float y_offset, float angle_offset, bool attach_x,
                     bool attach_y, bool attach_angle, bool x_angle_lock,
-                    bool y_angle_lock) {
+                    bool y_angle_lock)
+    : renderable(false) {
     set_x(x);
     set_y(y);
     set_z(z);
@@ -0,0 +1,198 @@
+/*
+  Wizard Engine
+  Copyright (C) 2023-2024 Zana Domán
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+// NOLINTNEXTLINE(bugprone-reserved-identifier,cert-dcl37-c,cert-dcl51-cpp)
+#define __WIZARD_ENGINE_INTERNAL__
+
+#include <wizard_engine/exception.hpp>
+#include <wizard_engine/renderer.hpp>
+#include <wizard_engine/texture_atlas.hpp>
+
+size_t wze::texture_atlas::fit(std::vector<segment> const& skyline,
+                               int32_t width, int32_t height,
+                               SDL_Point& position) const {
+    size_t best;
+    size_t index;
+    size_t covered;
+    int32_t top;
+    int32_t remaining;
+
+    best = skyline.size();
+    for (index = 0; index != skyline.size() &&
+                    skyline[index].x + width <= (int32_t)size();
+         ++index) {
+        top = 0;
+        remaining = width;
+        for (covered = index; 0 < remaining; ++covered) {
+            top = std::max(top, skyline[covered].y);
+            remaining -= skyline[covered].width;
+        }
+        if (top + height <= (int32_t)size() &&
+            (best == skyline.size() || top < position.y)) {
+            best = index;
+            position = {skyline[index].x, top};
+        }
+    }
+
+    return best;
+}
+
+void wze::texture_atlas::raise(std::vector<segment>& skyline, size_t index,
+                               SDL_Rect const& area) {
+    int32_t shrink;
+
+    skyline.insert(skyline.begin() + (std::ptrdiff_t)index,
+                   {area.x, area.y + area.h, area.w});
+
+    for (++index; index != skyline.size();) {
+        shrink = area.x + area.w - skyline[index].x;
+        if (shrink <= 0) {
+            break;
+        }
+        if (skyline[index].width <= shrink) {
+            skyline.erase(skyline.begin() + (std::ptrdiff_t)index);
+            continue;
+        }
+        skyline[index].x += shrink;
+        skyline[index].width -= shrink;
+        break;
+    }
+
+    for (index = 1; index < skyline.size();) {
+        if (skyline[index - 1].y == skyline[index].y) {
+            skyline[index - 1].width += skyline[index].width;
+            skyline.erase(skyline.begin() + (std::ptrdiff_t)index);
+        } else {
+            ++index;
+        }
+    }
+}
+
+void wze::texture_atlas::grow() {
+    std::shared_ptr<wze::texture> page;
+    std::vector<uint32_t> pixels;
+
+    page = {SDL_CreateTexture(renderer::base(), SDL_PIXELFORMAT_ARGB8888,
+                              SDL_TEXTUREACCESS_STATIC, size(), size()),
+            renderer::release};
+    pixels.resize((size_t)size() * size());
+    if (!page ||
+        (bool)SDL_SetTextureBlendMode(page.get(), SDL_BLENDMODE_BLEND) ||
+        (bool)SDL_UpdateTexture(page.get(), nullptr, pixels.data(),
+                                (int32_t)(size() * sizeof(uint32_t)))) {
+        throw exception(SDL_GetError());
+    }
+
+    _pages.push_back(page);
+    _skylines.push_back({{0, 0, size()}});
+}
+
+uint16_t wze::texture_atlas::size() const {
+    return _size;
+}
+
+std::vector<std::shared_ptr<wze::texture>> const&
+wze::texture_atlas::pages() const {
+    return _pages;
+}
+
+size_t wze::texture_atlas::regions() const {
+    return _regions;
+}
+
+wze::texture_region
+wze::texture_atlas::insert(std::shared_ptr<image> const& image) {
+    std::unique_ptr<wze::image, std::function<void(wze::image*)>> converted;
+    int32_t width;
+    int32_t height;
+    size_t page;
+    size_t index = 0;
+    SDL_Point position = {0, 0};
+    SDL_Rect area;
+
+    if (!image || size() < image->w || size() < image->h) {
+        throw exception("Image does not fit into the texture atlas");
+    }
+
+    converted = {SDL_ConvertSurfaceFormat(image.get(),
+                                          SDL_PIXELFORMAT_ARGB8888, 0),
+                 SDL_FreeSurface};
+    if (!converted) {
+        throw exception(SDL_GetError());
+    }
+
+    width = std::min(converted->w + _padding, (int32_t)size());
+    height = std::min(converted->h + _padding, (int32_t)size());
+    for (page = 0; page != pages().size(); ++page) {
+        index = fit(_skylines[page], width, height, position);
+        if (index != _skylines[page].size()) {
+            break;
+        }
+    }
+    if (page == pages().size()) {
+        grow();
+        index = fit(_skylines[page], width, height, position);
+    }
+
+    area = {position.x, position.y, converted->w, converted->h};
+    if ((bool)SDL_UpdateTexture(pages()[page].get(), &area,
+                                converted->pixels, converted->pitch)) {
+        throw exception(SDL_GetError());
+    }
+    raise(_skylines[page], index, {position.x, position.y, width, height});
+    ++_regions;
+
+    return {pages()[page],
+            {(float)area.x / size(), (float)area.y / size(),
+             (float)area.w / size(), (float)area.h / size()}};
+}
+
+std::vector<wze::texture_region> wze::texture_atlas::insert(
+    std::vector<std::shared_ptr<image>> const& images) {
+    std::vector<size_t> order;
+    std::vector<texture_region> regions;
+
+    if (std::any_of(images.begin(), images.end(),
+                    [](std::shared_ptr<image> const& image) -> bool {
+                        return !image;
+                    })) {
+        throw exception("Image does not fit into the texture atlas");
+    }
+
+    order.resize(images.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(),
+                     [&](size_t index1, size_t index2) -> bool {
+                         return images[index2]->h < images[index1]->h;
+                     });
+
+    regions.resize(images.size());
+    std::for_each(order.begin(), order.end(), [&](size_t index) -> void {
+        regions[index] = insert(images[index]);
+    });
+
+    return regions;
+}
+
+wze::texture_atlas::texture_atlas(uint16_t size) {
+    _size = size;
+    _regions = 0;
+}
@@ -0,0 +1,317 @@
+/*
+  Wizard Engine
+  Copyright (C) 2023-2024 Zana Domán
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+// NOLINTNEXTLINE(bugprone-reserved-identifier,cert-dcl37-c,cert-dcl51-cpp)
+#define __WIZARD_ENGINE_INTERNAL__
+
+#include <wizard_engine/exception.hpp>
+#include <wizard_engine/renderer.hpp>
+#include <wizard_engine/tilemap.hpp>
+
+std::vector<wze::tilemap*> wze::tilemap::_instances = {};
+
+size_t wze::tilemap::chunk_columns() const {
+    return (columns() + chunk_size() - 1) / chunk_size();
+}
+
+size_t wze::tilemap::chunk_rows() const {
+    return (rows() + chunk_size() - 1) / chunk_size();
+}
+
+void wze::tilemap::arrange() {
+    size_t chunk;
+    size_t first_column;
+    size_t first_row;
+    float width;
+    float height;
+
+    for (chunk = 0; chunk != _chunks.size(); ++chunk) {
+        first_column = chunk % chunk_columns() * chunk_size();
+        first_row = chunk / chunk_columns() * chunk_size();
+        width =
+            (float)std::min<size_t>(chunk_size(), columns() - first_column) *
+            tile_width();
+        height = (float)std::min<size_t>(chunk_size(), rows() - first_row) *
+                 tile_height();
+        _chunks[chunk].set_x(x() + (float)first_column * tile_width() +
+                             width / 2);
+        _chunks[chunk].set_y(y() + (float)first_row * tile_height() +
+                             height / 2);
+        _chunks[chunk].set_width(width);
+        _chunks[chunk].set_height(height);
+    }
+}
+
+void wze::tilemap::bake(size_t chunk) {
+    std::shared_ptr<wze::texture> texture;
+    size_t first_column;
+    size_t first_row;
+    size_t width;
+    size_t height;
+    size_t column;
+    size_t row;
+    uint16_t tile;
+    bool filled;
+    int32_t atlas_width;
+    int32_t atlas_columns;
+    SDL_Color modulation;
+    SDL_Rect source;
+    SDL_Rect destination;
+
+    first_column = chunk % chunk_columns() * chunk_size();
+    first_row = chunk / chunk_columns() * chunk_size();
+    width = std::min<size_t>(chunk_size(), columns() - first_column);
+    height = std::min<size_t>(chunk_size(), rows() - first_row);
+    _dirty[chunk] = (uint8_t) false;
+
+    filled = false;
+    for (row = 0; row != height && !filled; ++row) {
+        filled = std::any_of(
+            _tiles.begin() +
+                (std::ptrdiff_t)((first_row + row) * columns() + first_column),
+            _tiles.begin() + (std::ptrdiff_t)((first_row + row) * columns() +
+                                              first_column + width),
+            [](uint16_t tile) -> bool { return (bool)tile; });
+    }
+
+    if (!atlas() || !filled) {
+        _chunks[chunk].set_texture({});
+        return;
+    }
+
+    if (_chunks[chunk].texture().use_count() == 1) {
+        texture = _chunks[chunk].texture();
+    } else {
+        texture = {SDL_CreateTexture(renderer::base(), SDL_PIXELFORMAT_RGBA8888,
+                                     SDL_TEXTUREACCESS_TARGET,
+                                     (int32_t)(width * cell_width()),
+                                     (int32_t)(height * cell_height())),
+                   renderer::release};
+        if (!texture || (bool)SDL_SetTextureBlendMode(texture.get(),
+                                                      SDL_BLENDMODE_BLEND)) {
+            throw exception(SDL_GetError());
+        }
+    }
+
+    if ((bool)SDL_QueryTexture(atlas().get(), nullptr, nullptr, &atlas_width,
+                               nullptr) ||
+        (bool)SDL_GetTextureColorMod(atlas().get(), &modulation.r,
+                                     &modulation.g, &modulation.b) ||
+        (bool)SDL_GetTextureAlphaMod(atlas().get(), &modulation.a) ||
+        (bool)SDL_SetTextureColorMod(
+            atlas().get(), std::numeric_limits<uint8_t>::max(),
+            std::numeric_limits<uint8_t>::max(),
+            std::numeric_limits<uint8_t>::max()) ||
+        (bool)SDL_SetTextureAlphaMod(atlas().get(),
+                                     std::numeric_limits<uint8_t>::max()) ||
+        (bool)SDL_SetRenderTarget(renderer::base(), texture.get()) ||
+        (bool)SDL_SetRenderDrawColor(renderer::base(), 0, 0, 0, 0) ||
+        (bool)SDL_RenderClear(renderer::base())) {
+        throw exception(SDL_GetError());
+    }
+
+    atlas_columns = std::max(atlas_width / cell_width(), 1);
+    for (row = 0; row != height; ++row) {
+        for (column = 0; column != width; ++column) {
+            tile = this->tile(first_column + column, first_row + row);
+            if (!(bool)tile) {
+                continue;
+            }
+            source = {(tile - 1) % atlas_columns * cell_width(),
+                      (tile - 1) / atlas_columns * cell_height(), cell_width(),
+                      cell_height()};
+            destination = {(int32_t)(column * cell_width()),
+                           (int32_t)(row * cell_height()), cell_width(),
+                           cell_height()};
+            if ((bool)SDL_RenderCopy(renderer::base(), atlas().get(), &source,
+                                     &destination)) {
+                throw exception(SDL_GetError());
+            }
+        }
+    }
+
+    if ((bool)SDL_SetRenderTarget(renderer::base(), nullptr) ||
+        (bool)SDL_SetTextureColorMod(atlas().get(), modulation.r,
+                                     modulation.g, modulation.b) ||
+        (bool)SDL_SetTextureAlphaMod(atlas().get(), modulation.a)) {
+        throw exception(SDL_GetError());
+    }
+
+    _chunks[chunk].set_texture(texture);
+}
+
+float wze::tilemap::x() const {
+    return _x;
+}
+
+void wze::tilemap::set_x(float x) {
+    _x = x;
+    arrange();
+}
+
+float wze::tilemap::y() const {
+    return _y;
+}
+
+void wze::tilemap::set_y(float y) {
+    _y = y;
+    arrange();
+}
+
+float wze::tilemap::z() const {
+    return _z;
+}
+
+void wze::tilemap::set_z(float z) {
+    _z = z;
+    std::for_each(_chunks.begin(), _chunks.end(),
+                  [&](sprite& chunk) -> void { chunk.set_z(z); });
+}
+
+float wze::tilemap::tile_width() const {
+    return _tile_width;
+}
+
+float wze::tilemap::tile_height() const {
+    return _tile_height;
+}
+
+bool wze::tilemap::spatial() const {
+    return _spatial;
+}
+
+void wze::tilemap::set_spatial(bool spatial) {
+    _spatial = spatial;
+    std::for_each(_chunks.begin(), _chunks.end(),
+                  [&](sprite& chunk) -> void { chunk.set_spatial(spatial); });
+}
+
+std::shared_ptr<wze::texture> const& wze::tilemap::atlas() const {
+    return _atlas;
+}
+
+uint16_t wze::tilemap::cell_width() const {
+    return _cell_width;
+}
+
+uint16_t wze::tilemap::cell_height() const {
+    return _cell_height;
+}
+
+size_t wze::tilemap::columns() const {
+    return _columns;
+}
+
+size_t wze::tilemap::rows() const {
+    return _rows;
+}
+
+uint16_t wze::tilemap::chunk_size() const {
+    return _chunk_size;
+}
+
+bool wze::tilemap::visible() const {
+    return _visible;
+}
+
+void wze::tilemap::set_visible(bool visible) {
+    _visible = visible;
+    std::for_each(_chunks.begin(), _chunks.end(),
+                  [&](sprite& chunk) -> void { chunk.set_visible(visible); });
+}
+
+uint8_t wze::tilemap::priority() const {
+    return _priority;
+}
+
+void wze::tilemap::set_priority(uint8_t priority) {
+    _priority = priority;
+    std::for_each(_chunks.begin(), _chunks.end(),
+                  [&](sprite& chunk) -> void { chunk.set_priority(priority); });
+}
+
+uint16_t wze::tilemap::tile(size_t column, size_t row) const {
+    return _tiles[row * columns() + column];
+}
+
+void wze::tilemap::set_tile(size_t column, size_t row, uint16_t tile) {
+    _tiles[row * columns() + column] = tile;
+    _dirty[row / chunk_size() * chunk_columns() + column / chunk_size()] =
+        (uint8_t) true;
+}
+
+void wze::tilemap::bake() {
+    size_t chunk;
+
+    for (chunk = 0; chunk != _chunks.size(); ++chunk) {
+        if ((bool)_dirty[chunk]) {
+            bake(chunk);
+        }
+    }
+}
+
+void wze::tilemap::reset() {
+    std::for_each(_instances.begin(), _instances.end(),
+                  [](tilemap* instance) -> void {
+                      std::fill(instance->_dirty.begin(),
+                                instance->_dirty.end(), (uint8_t) true);
+                      instance->bake();
+                  });
+}
+
+wze::tilemap::tilemap(float x, float y, float z, float tile_width,
+                      float tile_height, bool spatial,
+                      std::shared_ptr<wze::texture> const& atlas,
+                      uint16_t cell_width, uint16_t cell_height, size_t columns,
+                      size_t rows, std::vector<uint16_t> const& tiles,
+                      uint16_t chunk_size, bool visible, uint8_t priority) {
+    _instances.push_back(this);
+    _tile_width = tile_width;
+    _tile_height = tile_height;
+    _atlas = atlas;
+    _cell_width = cell_width;
+    _cell_height = cell_height;
+    _columns = columns;
+    _rows = rows;
+    _chunk_size = std::max<uint16_t>(chunk_size, 1);
+    _tiles = tiles;
+    _tiles.resize(this->columns() * this->rows());
+    _chunks.resize(chunk_columns() * chunk_rows());
+    _dirty.resize(_chunks.size(), (uint8_t) true);
+    std::for_each(_chunks.begin(), _chunks.end(),
+                  [](sprite& chunk) -> void { chunk.set_animated(false); });
+    set_x(x);
+    set_y(y);
+    set_z(z);
+    set_spatial(spatial);
+    set_visible(visible);
+    set_priority(priority);
+    bake();
+}
+
+wze::tilemap::tilemap(tilemap const& other) {
+    _instances.push_back(this);
+    *this = other;
+}
+
+wze::tilemap::~tilemap() {
+    _instances.erase(std::find(_instances.begin(), _instances.end(), this));
+}
@@ -30,14 +30,22 @@
 
 #include <wizard_engine/timer.hpp>
 
-uint8_t wze::timer::frame_time() {
+float wze::timer::frame_time() {
     return _frame_time;
 }
 
-void wze::timer::set_frame_time(uint8_t frame_time) {
+void wze::timer::set_frame_time(float frame_time) {
     _frame_time = frame_time;
 }
 
+bool wze::timer::precise() {
+    return _precise;
+}
+
+void wze::timer::set_precise(bool precise) {
+    _precise = precise;
+}
+
 float wze::timer::delta_time() {
     return _delta_time;
 }
@@ -46,21 +54,104 @@ void wze::timer::set_delta_time(float delta_time) {
     _delta_time = delta_time;
 }
 
+float wze::timer::fixed_delta_time() {
+    return _fixed_delta_time;
+}
+
+void wze::timer::set_fixed_delta_time(float fixed_delta_time) {
+    _fixed_delta_time = fixed_delta_time;
+}
+
 uint32_t wze::timer::current_time() {
     return SDL_GetTicks();
 }
 
+wze::pacing_stats const& wze::timer::stats() {
+    return _stats;
+}
+
+void wze::timer::reset_stats() {
+    _stats = {};
+}
+
+uint64_t wze::timer::ticks(float milliseconds) {
+    constexpr double second = 1000;
+
+    return (uint64_t)((double)milliseconds *
+                      (double)SDL_GetPerformanceFrequency() / second);
+}
+
+float wze::timer::milliseconds(uint64_t ticks) {
+    constexpr double second = 1000;
+
+    return (float)((double)ticks * second /
+                   (double)SDL_GetPerformanceFrequency());
+}
+
+uint64_t wze::timer::wait(uint64_t deadline) {
+    constexpr float spin_time = 2;
+    uint64_t now;
+    float remaining;
+
+    now = SDL_GetPerformanceCounter();
+    while (now < deadline) {
+        remaining = milliseconds(deadline - now);
+        if (spin_time < remaining) {
+            SDL_Delay((uint32_t)(remaining - spin_time));
+        }
+        now = SDL_GetPerformanceCounter();
+    }
+
+    return now;
+}
+
+void wze::timer::record(uint64_t now, uint64_t deadline, bool missed) {
+    ++_stats.frames;
+    if (missed) {
+        ++_stats.missed;
+    }
+    _stats.error = now < deadline ? -milliseconds(deadline - now)
+                                  : milliseconds(now - deadline);
+    _stats.mean_error +=
+        (_stats.error - _stats.mean_error) / (float)_stats.frames;
+    _stats.max_error = std::max(_stats.max_error, _stats.error);
+}
+
 void wze::timer::update() {
-    uint32_t end{_last_time + frame_time()};
-    uint32_t now{current_time()};
-    if (now < end) {
-        SDL_Delay(end - now);
-        now = end;
+    uint64_t now;
+    uint64_t deadline;
+    bool missed;
+
+    now = SDL_GetPerformanceCounter();
+    if (0 < fixed_delta_time()) {
+        set_delta_time(fixed_delta_time());
+        _last_time = _deadline = now;
+        return;
+    }
+    if (!(bool)_last_time) {
+        _last_time = _deadline = now;
+    }
+
+    if (0 < frame_time()) {
+        deadline = (precise() ? _deadline : _last_time) + ticks(frame_time());
+        missed = deadline < now;
+        if (!missed && precise()) {
+            now = wait(deadline);
+        } else if (!missed) {
+            SDL_Delay((uint32_t)ceilf(milliseconds(deadline - now)));
+            now = SDL_GetPerformanceCounter();
+        }
+        record(now, deadline, missed);
+        _deadline = missed ? now : deadline;
     }
-    set_delta_time((float)(now - _last_time));
+    set_delta_time(milliseconds(now - _last_time));
     _last_time = now;
 }
 
-uint8_t wze::timer::_frame_time{};
+float wze::timer::_frame_time{};
+bool wze::timer::_precise{};
 float wze::timer::_delta_time{};
-uint32_t wze::timer::_last_time{};
+float wze::timer::_fixed_delta_time{};
+uint64_t wze::timer::_last_time{};
+uint64_t wze::timer::_deadline{};
+wze::pacing_stats wze::timer::_stats{};
@@ -62,19 +62,25 @@ bool wze::window::focused() {
 }
 
 void wze::window::initialize(std::string const& title, uint16_t width,
-                             uint16_t height) {
-    _base = SDL_CreateWindow(title.empty() ? "Wizard Engine" : title.c_str(),
-                             SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
-                             width, height,
-                             SDL_WINDOW_RESIZABLE
+                             uint16_t height, bool hidden) {
+    uint32_t flags;
+
+    flags = hidden ? SDL_WINDOW_HIDDEN : SDL_WINDOW_RESIZABLE;
 #ifndef __EMSCRIPTEN__
-                                 | SDL_WINDOW_FULLSCREEN_DESKTOP
+    if (!hidden) {
+        flags |= SDL_WINDOW_FULLSCREEN_DESKTOP;
+    }
 #endif /* __EMSCRIPTEN__ */
-    );
+
+    _base = SDL_CreateWindow(title.empty() ? "Wizard Engine" : title.c_str(),
+                             SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
+                             width, height, flags);
     if (!(bool)base()) {
         throw exception(SDL_GetError());
     }
     _width = width;
     _height = height;
-    set_icon(assets::load_image("./wizard_engine/icon.png"));
+    if (!hidden) {
+        set_icon(assets::load_image("./wizard_engine/icon.png"));
+    }
 }
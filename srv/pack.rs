@@ -0,0 +1,112 @@
+/*
+  Wizard Engine
+  Copyright (C) 2023-2024 Zana Domán
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+
+use clap::Parser;
+use std::{
+    fs::{read, read_dir, File},
+    io::{BufWriter, Error, Write},
+    path::{Path, PathBuf},
+};
+
+const MAGIC: &[u8; 8] = b"WZEPACK\0";
+const HEADER_SIZE: u64 = 16;
+const ENTRY_SIZE: u64 = 40;
+const OFFSET_BASIS: u64 = 14695981039346656037;
+const PRIME: u64 = 1099511628211;
+
+#[derive(Parser)]
+#[command(version, about = "Asset pack builder for Wizard Engine")]
+struct Args {
+    #[arg(help = "Directory of the assets")]
+    input: PathBuf,
+    #[arg(help = "Path of the pack")]
+    output: PathBuf,
+}
+
+struct Asset {
+    hash: u64,
+    path: String,
+    content: Vec<u8>,
+}
+
+fn hash(path: &str) -> u64 {
+    path.bytes().fold(OFFSET_BASIS, |hash, byte| {
+        (hash ^ u64::from(byte)).wrapping_mul(PRIME)
+    })
+}
+
+fn collect(
+    root: &Path,
+    directory: &Path,
+    assets: &mut Vec<Asset>,
+) -> Result<(), Error> {
+    for entry in read_dir(directory)? {
+        let path = entry?.path();
+        if path.is_dir() {
+            collect(root, &path, assets)?;
+            continue;
+        }
+        let key = path
+            .strip_prefix(root)
+            .map_err(Error::other)?
+            .components()
+            .map(|component| component.as_os_str().to_string_lossy())
+            .collect::<Vec<_>>()
+            .join("/");
+        assets.push(Asset {
+            hash: hash(&key),
+            path: key,
+            content: read(&path)?,
+        });
+    }
+    Ok(())
+}
+
+fn main() -> Result<(), Error> {
+    let args = Args::parse();
+    let mut assets = Vec::new();
+    collect(&args.input, &args.input, &mut assets)?;
+    assets.sort_by(|asset1, asset2| {
+        (asset1.hash, &asset1.path).cmp(&(asset2.hash, &asset2.path))
+    });
+
+    let mut writer = BufWriter::new(File::create(&args.output)?);
+    writer.write_all(MAGIC)?;
+    writer.write_all(&(assets.len() as u64).to_le_bytes())?;
+    let mut offset = HEADER_SIZE + ENTRY_SIZE * assets.len() as u64;
+    for asset in &assets {
+        let path_size = asset.path.len() as u64;
+        let size = asset.content.len() as u64;
+        for field in [asset.hash, offset, path_size, offset + path_size, size]
+        {
+            writer.write_all(&field.to_le_bytes())?;
+        }
+        offset += path_size + size;
+    }
+    for asset in &assets {
+        writer.write_all(asset.path.as_bytes())?;
+        writer.write_all(&asset.content)?;
+    }
+    writer.flush()?;
+    println!("{} assets packed into {:?}", assets.len(), args.output);
+    Ok(())
+}
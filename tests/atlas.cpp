@@ -0,0 +1,72 @@
+/*
+  Wizard Engine
+  Copyright (C) 2023-2024 Zana Domán
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <wizard_engine/wizard_engine.hpp>
+
+constexpr size_t columns = 32;
+constexpr size_t rows = 18;
+constexpr float sprite_size = 60;
+constexpr uint16_t frame_time = 250;
+constexpr uint32_t phase = 25;
+
+wze_main("Wizard Engine - Atlas", 1920, 1080) {
+    wze::texture_atlas atlas;
+    std::vector<wze::texture_region> regions;
+    std::vector<std::pair<wze::texture_region, uint16_t>> frames;
+    std::vector<std::shared_ptr<wze::sprite>> sprites;
+    wze::animator animator;
+    size_t i;
+
+    regions =
+        atlas.insert({wze::assets::load_image("./tests/image.png"),
+                      wze::assets::load_image("./wizard_engine/icon.png"),
+                      wze::assets::load_image("./wizard_engine/logo.png")});
+    std::for_each(regions.begin(), regions.end(),
+                  [&](wze::texture_region const& region) -> void {
+                      frames.emplace_back(region, frame_time);
+                  });
+    animator.set_frames(frames);
+
+    for (i = 0; i != columns * rows; ++i) {
+        sprites.push_back(std::make_shared<wze::sprite>(
+            ((float)(i % columns) + .5F) * sprite_size -
+                (float)columns * sprite_size / 2,
+            ((float)(i / columns) + .5F) * sprite_size -
+                (float)rows * sprite_size / 2,
+            0, 0, sprite_size, sprite_size));
+        sprites.back()->set_region(regions.at(i % regions.size()));
+        sprites.back()->set_animated((bool)(i % 2));
+        animator.attach(*sprites.back(), (uint32_t)(i % columns) * phase);
+    }
+
+    wze::engine::log(std::to_string(atlas.regions()) + " regions packed into " +
+                     std::to_string(atlas.pages().size()) + " pages");
+
+    wze_while(true) {
+        if (wze::input::key(wze::KEY_SPACE)) {
+            wze::engine::log(
+                std::to_string(wze::renderer::stats().calls) + " calls, " +
+                std::to_string(wze::renderer::stats().switches) + " switches");
+        }
+    }
+
+    return 0;
+}
@@ -26,36 +26,29 @@ constexpr uint16_t line_width = 800;
 
 wze_main("Wizard Engine - Text", 1920, 1080) {
     std::string text;
-    bool update;
-    std::shared_ptr<wze::font> font;
-    std::shared_ptr<wze::image> image;
-    wze::sprite sprite;
+    std::shared_ptr<wze::glyph_atlas> atlas;
+    wze::label label;
 
-    font = wze::assets::load_font("./tests/font.ttf", font_size,
-                                  wze::FONT_STYLE_NORMAL,
-                                  wze::FONT_ALIGNMENT_CENTER);
+    atlas = std::make_shared<wze::glyph_atlas>(wze::assets::load_font(
+        "./tests/font.ttf", font_size, wze::FONT_STYLE_NORMAL,
+        wze::FONT_ALIGNMENT_CENTER));
+    label.set_atlas(atlas);
+    label.set_wrap_length(line_width);
 
     wze_while(true) {
-        update = false;
         if (wze::input::key() == '\b') {
             if (!text.empty()) {
                 text.pop_back();
-                update = true;
             }
         } else if (wze::input::key() != '\0') {
             text.push_back((char)wze::input::key());
-            update = true;
         }
-        if (update) {
-            try {
-                image = wze::assets::create_image(text, font, line_width);
-            } catch (...) {
-                sprite.set_texture(nullptr);
-                continue;
+        try {
+            label.set_text(text);
+        } catch (...) {
+            if (!text.empty()) {
+                text.pop_back();
             }
-            sprite.set_width((float)image->w);
-            sprite.set_height((float)image->h);
-            sprite.set_texture(wze::assets::create_texture(image));
         }
     }
 
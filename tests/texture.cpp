@@ -0,0 +1,77 @@
+/*
+  Wizard Engine
+  Copyright (C) 2023-2024 Zana Domán
+
+  This software is provided 'as-is', without any express or implied
+  warranty. In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include <wizard_engine/wizard_engine.hpp>
+
+constexpr size_t iterations = 100;
+constexpr float milliseconds = 1000;
+constexpr float sprite_size = 512;
+
+wze_main("Wizard Engine - Texture", 1920, 1080) {
+    std::array<std::string, 3> paths;
+    std::function<void(std::string const&)> benchmark;
+    uint64_t start;
+    float png_time;
+    float raw_time;
+    bool caching;
+    size_t i;
+    wze::sprite sprite;
+
+    benchmark = [&](std::string const& path) -> void {
+        wze::assets::save_texture(wze::assets::load_image(path),
+                                  path + ".wzt");
+
+        start = SDL_GetPerformanceCounter();
+        for (i = 0; i != iterations; ++i) {
+            static_cast<void>(wze::assets::create_texture(
+                wze::assets::load_image(path)));
+        }
+        png_time = (float)(SDL_GetPerformanceCounter() - start) *
+                   milliseconds / (float)SDL_GetPerformanceFrequency() /
+                   iterations;
+
+        start = SDL_GetPerformanceCounter();
+        for (i = 0; i != iterations; ++i) {
+            static_cast<void>(wze::assets::load_texture(path + ".wzt"));
+        }
+        raw_time = (float)(SDL_GetPerformanceCounter() - start) *
+                   milliseconds / (float)SDL_GetPerformanceFrequency() /
+                   iterations;
+
+        wze::engine::log(path + ": png " + std::to_string(png_time) +
+                         " ms, raw " + std::to_string(raw_time) + " ms");
+    };
+
+    paths = {"./tests/image.png", "./wizard_engine/icon.png",
+             "./wizard_engine/logo.png"};
+
+    caching = wze::assets::caching();
+    wze::assets::set_caching(false);
+    std::for_each(paths.begin(), paths.end(), benchmark);
+    wze::assets::set_caching(caching);
+
+    sprite = wze::sprite(0, 0, 0, 0, sprite_size, sprite_size, false,
+                         wze::assets::load_texture(paths[1] + ".wzt"));
+
+    wze_while(true) {}
+
+    return 0;
+}